@@ -0,0 +1,128 @@
+/*
+    Microbenchmark for src/format.c against the swprintf calls it replaces,
+    it also checks every value formats the same way both ways.
+
+    cmake --build build --target format_bench && ./build/format_bench
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <wchar.h>
+
+#include "../src/format.h"
+
+#define SAMPLES (1 << 20)
+
+static unsigned long long bench_state = 0x9E3779B97F4A7C15ULL;
+
+static unsigned long long bench_rand(void) {
+    // xorshift64*
+    bench_state ^= bench_state >> 12;
+    bench_state ^= bench_state << 25;
+    bench_state ^= bench_state >> 27;
+    return bench_state * 0x2545F4914F6CDD1DULL;
+}
+
+static double bench_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// the sort of values people actually put in lists
+static double random_flt(int i) {
+    unsigned long long r = bench_rand();
+    switch (i % 3) {
+        case 0: return (double)(long long)(r % 2000000) / 100 - 10000;
+        case 1: return (double)(r % 1000000) / (1 + r % 997);
+        default: return (r >> 11) * 0x1.0p-53 * (i % 2 ? 1e-3 : 1e7);
+    }
+}
+
+// anything at all, these mostly take the swprintf fallback so we only check them
+static double random_bits_flt(void) {
+    unsigned long long r = bench_rand();
+    double flt;
+    memcpy(&flt, &r, sizeof(flt));
+    return flt;
+}
+
+static long long random_int(int i) {
+    unsigned long long r = bench_rand();
+    switch (i % 3) {
+        case 0: return (long long)(r % 2000) - 1000;
+        case 1: return (long long)(r % 2000000000) - 1000000000;
+        default: return (long long)r;
+    }
+}
+
+static int check(const char *what, const wchar_t *fast, int fast_len,
+                 const wchar_t *slow, int slow_len) {
+    if (fast_len == slow_len && wmemcmp(fast, slow, fast_len) == 0) return 0;
+    fprintf(stderr, "%s mismatch: '%.*ls' vs swprintf's '%.*ls'\n",
+            what, fast_len, fast, slow_len, slow);
+    return 1;
+}
+
+int main(void) {
+    double *flts = malloc(sizeof(double) * SAMPLES);
+    long long *ints = malloc(sizeof(long long) * SAMPLES);
+    for (int i = 0; i < SAMPLES; i++) {
+        flts[i] = random_flt(i);
+        ints[i] = random_int(i);
+    }
+
+    int failures = 0;
+    wchar_t fast[FORMAT_MAX_LEN], slow[FORMAT_MAX_LEN];
+    for (int i = 0; i < SAMPLES && failures < 10; i++) {
+        int fast_len = format_flt(fast, flts[i]);
+        int slow_len = swprintf(slow, FORMAT_MAX_LEN, L"%.5g", flts[i]);
+        failures += check("%.5g", fast, fast_len, slow, slow_len);
+
+        double bits = random_bits_flt();
+        fast_len = format_flt(fast, bits);
+        slow_len = swprintf(slow, FORMAT_MAX_LEN, L"%.5g", bits);
+        failures += check("%.5g", fast, fast_len, slow, slow_len);
+
+        fast_len = format_int(fast, ints[i]);
+        slow_len = swprintf(slow, FORMAT_MAX_LEN, L"%lld", ints[i]);
+        failures += check("%lld", fast, fast_len, slow, slow_len);
+
+        void *ptr = (void*)(uintptr_t)(i % 7 == 0 ? 0 : ints[i]);
+        fast_len = format_ptr(fast, ptr);
+        slow_len = swprintf(slow, FORMAT_MAX_LEN, L"%p", ptr);
+        failures += check("%p", fast, fast_len, slow, slow_len);
+    }
+    if (failures > 0) return 1;
+
+    // sum the lengths so nothing gets optimised away
+    long long total = 0;
+    double start = bench_now();
+    for (int i = 0; i < SAMPLES; i++) total += swprintf(slow, FORMAT_MAX_LEN, L"%.5g", flts[i]);
+    double slow_flt = bench_now() - start;
+
+    start = bench_now();
+    for (int i = 0; i < SAMPLES; i++) total += format_flt(fast, flts[i]);
+    double fast_flt = bench_now() - start;
+
+    start = bench_now();
+    for (int i = 0; i < SAMPLES; i++) total += swprintf(slow, FORMAT_MAX_LEN, L"%lld", ints[i]);
+    double slow_int = bench_now() - start;
+
+    start = bench_now();
+    for (int i = 0; i < SAMPLES; i++) total += format_int(fast, ints[i]);
+    double fast_int = bench_now() - start;
+
+    printf("%d samples each (checksum %lld)\n", SAMPLES, total);
+    printf("%%.5g  swprintf %7.1f ns  format_flt %6.1f ns  (%.1fx)\n",
+           slow_flt * 1e9 / SAMPLES, fast_flt * 1e9 / SAMPLES, slow_flt / fast_flt);
+    printf("%%lld  swprintf %7.1f ns  format_int %6.1f ns  (%.1fx)\n",
+           slow_int * 1e9 / SAMPLES, fast_int * 1e9 / SAMPLES, slow_int / fast_int);
+
+    free(flts);
+    free(ints);
+    return 0;
+}
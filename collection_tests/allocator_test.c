@@ -0,0 +1,204 @@
+#include "../include/collections/ll.h"
+#include "../include/collections/dll.h"
+#include "../include/collections/list.h"
+#include "../include/collections/array.h"
+#include "../lib/obsidian.h"
+#include "../include/llv.h"
+#include "collection_test_helper.h"
+#include "../include/types/allocator.h"
+#include <string.h>
+#include <stddef.h>
+
+// counts what goes through it and hands the rest to malloc
+typedef struct _counting_t {
+    long long allocs;
+    long long frees;
+    long long live_bytes;
+} Counting;
+
+static void *counting_alloc(void *ctx, size_t size) {
+    Counting *counting = (Counting*)ctx;
+    counting->allocs++;
+    counting->live_bytes += size;
+    return malloc(size);
+}
+
+static void *counting_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+    Counting *counting = (Counting*)ctx;
+    if (ptr == NULL) counting->allocs++;
+    counting->live_bytes += (long long)new_size - (long long)old_size;
+    return realloc(ptr, new_size);
+}
+
+static void counting_free(void *ctx, void *ptr, size_t size) {
+    Counting *counting = (Counting*)ctx;
+    counting->frees++;
+    counting->live_bytes -= size;
+    free(ptr);
+}
+
+static struct _llv_allocator_t counting_allocator(Counting *counting) {
+    return (struct _llv_allocator_t) {
+        counting_alloc, counting_realloc, counting_free, counting
+    };
+}
+
+int main(int argc, char *argv[]) {
+    OBS_SETUP("Allocator")
+
+    OBS_TEST_GROUP("llv_set_allocator", {
+        OBS_TEST("Defaults to malloc and NULL goes back to it", {
+            obs_test_eq(llv_allocator(), llv_malloc_allocator());
+            Counting counting = {0};
+            struct _llv_allocator_t mine = counting_allocator(&counting);
+            obs_test_eq(llv_set_allocator(&mine), llv_malloc_allocator());
+            obs_test_eq(llv_set_allocator(NULL), &mine);
+            obs_test_eq(llv_allocator(), llv_malloc_allocator());
+        })
+
+        OBS_TEST("Collections keep the allocator they were made with", {
+            Counting counting = {0};
+            struct _llv_allocator_t mine = counting_allocator(&counting);
+            llv_set_allocator(&mine);
+            List list = list_new("list");
+            Array array = array_new("array", 4);
+            llv_set_allocator(NULL);
+
+            obs_test_eq(list->parent.allocator, &mine);
+            obs_test_eq(array->parent.allocator, &mine);
+            obs_test_eq(counting.allocs, (long long)3);
+
+            // growing goes through the collection's allocator not the current one
+            for (int i = 0; i < 100; i++) list_push_back(list, NEW_NODE(list, i));
+            array_resize(array, 50);
+            obs_test_gt(counting.live_bytes, (long long)(sizeof(struct _list_data_t) * 150));
+            for (int i = 0; i < 100; i++) obs_test_eq(list->data[i].data.int_data, (long long)i);
+
+            list_free(list);
+            array_free(array);
+            obs_test_eq(counting.frees, (long long)4);
+            obs_test_eq(counting.live_bytes, (long long)0);
+        })
+
+        OBS_TEST("Node pools follow the allocator once drained", {
+            Counting counting = {0};
+            struct _llv_allocator_t mine = counting_allocator(&counting);
+            llv_set_allocator(&mine);
+            DLL list = dll_new("list");
+            for (int i = 0; i < 10; i++) dll_append(list, NEW_NODE(dll, i));
+            llv_set_allocator(NULL);
+
+            // the slab and the list itself
+            obs_test_eq(counting.allocs, (long long)2);
+            dll_free(list);
+            obs_test_eq(counting.live_bytes, (long long)0);
+
+            list = dll_new("list");
+            dll_append(list, NEW_NODE(dll, 1));
+            obs_test_eq(counting.allocs, (long long)2);
+            dll_free(list);
+        })
+
+        OBS_TEST("Clearing a list leaves the pool alone while other nodes are out", {
+            Counting counting = {0};
+            struct _llv_allocator_t mine = counting_allocator(&counting);
+            llv_set_allocator(&mine);
+            LL list = ll_from_array("list", DATA_ARRAY(((int[]){1, 2, 3})), 3);
+            llv_set_allocator(NULL);
+
+            // taken out by hand so len still counts it
+            LL_Node held = list->head;
+            list->head = held->next;
+            held->next = NULL;
+            ll_clear(list);
+            obs_test_gt(counting.live_bytes, (long long)sizeof(struct _singly_linked_list_t));
+            obs_test_eq(held->data.int_data, (long long)1);
+
+            // the last node back lets the slabs go
+            ll_free_node(held);
+            ll_free(list);
+            obs_test_eq(counting.live_bytes, (long long)0);
+        })
+    })
+
+    OBS_TEST_GROUP("llv_arena", {
+        OBS_TEST("Allocations are aligned and reuse memory after a reset", {
+            LLVAllocator arena = llv_arena_new(256);
+            char *first = llv_alloc(arena, 3, "test");
+            long double *second = llv_alloc(arena, sizeof(long double), "test");
+            int misaligned = (int)((size_t)second % _Alignof(max_align_t));
+            obs_test_eq(misaligned, 0);
+            obs_test_gte((int)llv_arena_used(arena), (int)(3 + sizeof(long double)));
+
+            // too big for a block gets a block of its own
+            char *big = llv_alloc(arena, 1000, "test");
+            memset(big, 'x', 1000);
+
+            llv_arena_reset(arena);
+            obs_test_eq((int)llv_arena_used(arena), 0);
+            obs_test_eq((char*)llv_alloc(arena, 3, "test"), first);
+            llv_arena_free(arena);
+        })
+
+        OBS_TEST("The latest allocation grows and shrinks in place", {
+            LLVAllocator arena = llv_arena_new(0);
+            char *str = llv_strdup(arena, "Hello");
+            char *grown = llv_realloc(arena, str, 6, 100, "test");
+            obs_test_eq(grown, str);
+            obs_test_strcmp(grown, "Hello");
+
+            // freeing the latest allocation gives it back
+            size_t used = llv_arena_used(arena);
+            char *scratch = llv_alloc(arena, 64, "test");
+            llv_free(arena, scratch, 64);
+            obs_test_eq((int)llv_arena_used(arena), (int)used);
+
+            // anything older has to be copied
+            llv_alloc(arena, 1, "test");
+            char *moved = llv_realloc(arena, grown, 100, 200, "test");
+            obs_test_neq(moved, grown);
+            obs_test_strcmp(moved, "Hello");
+            llv_arena_free(arena);
+        })
+
+        OBS_TEST("A whole demo goes away in one reset", {
+            LLVAllocator arena = llv_arena_new(1024);
+            for (int round = 0; round < 3; round++) {
+                llv_set_allocator(arena);
+                LL ll = ll_new(llv_strdup(NULL, "ll"));
+                DLL dll = dll_new(llv_strdup(NULL, "dll"));
+                List list = list_new(llv_strdup(NULL, "list"));
+                for (int i = 0; i < 200; i++) {
+                    ll_append(ll, NEW_NODE(ll, i));
+                    dll_append(dll, NEW_NODE(dll, i));
+                    list_push_back(list, NEW_NODE(list, llv_strdup(NULL, "str")));
+                }
+                llv_set_allocator(NULL);
+
+                obs_test_strcmp(ll->parent.name, "ll");
+                obs_test_eq(ll->tail->data.int_data, (long long)199);
+                obs_test_eq(dll->tail->data.int_data, (long long)199);
+                obs_test_strcmp(list->data[199].data.str_data, "str");
+
+                // no frees, the reset takes everything (node pools included)
+                llv_arena_reset(arena);
+            }
+
+            // nodes made after the reset don't come from the arena
+            LL ll = ll_new("ll");
+            ll_append(ll, NEW_NODE(ll, 1));
+            llv_arena_free(arena);
+            obs_test_eq(ll->head->data.int_data, (long long)1);
+            ll_free(ll);
+        })
+
+        OBS_TEST("Freeing the current arena goes back to malloc", {
+            LLVAllocator arena = llv_arena_new(0);
+            llv_set_allocator(arena);
+            llv_arena_free(arena);
+            obs_test_eq(llv_allocator(), llv_malloc_allocator());
+        })
+    })
+
+    OBS_REPORT;
+}
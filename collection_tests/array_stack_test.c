@@ -0,0 +1,69 @@
+#include "../include/collections/array_stack.h"
+#include "../lib/obsidian.h"
+#include "../include/llv.h"
+#include "collection_test_helper.h"
+#include "../include/types/collection_skeleton.h"
+#include "../include/types/shared_types.h"
+#include <string.h>
+
+int main(int argc, char *argv[]) {
+    OBS_SETUP("Array Stack")
+
+    OBS_TEST_GROUP("array_stack_new && array_stack_new_node", {
+        OBS_TEST("Create stack and test properties", {
+            ArrayStack stack = array_stack_new("1");
+            obs_test_strcmp(stack->parent.name, "1");
+            obs_test_eq(array_stack_length(stack), 0);
+            obs_test_true(array_stack_is_empty(stack));
+            obs_test_null(array_stack_top(stack));
+            array_stack_free(stack);
+        })
+
+        OBS_TEST("Create node using generic macros", {
+            struct _array_stack_data_t node = NEW_NODE(array_stack, 5.9);
+            obs_test_eq(node.data_tag, FLOAT);
+            obs_test_null(node.ptr);
+            obs_test_eq(node.data.flt_data, 5.9);
+        })
+    })
+
+    OBS_TEST_GROUP("array_stack_push && array_stack_pop", {
+        OBS_TEST("Last in first out", {
+            ArrayStack stack = array_stack_new("stack");
+            for (int i = 0; i < 100; i++) array_stack_push(stack, NEW_NODE(array_stack, i));
+            obs_test_eq(array_stack_length(stack), 100);
+            obs_test_eq(stack->capacity, 128);
+            obs_test_eq(array_stack_top(stack)->data.int_data, (long long)99);
+            obs_test_eq(array_stack_at(stack, 0)->data.int_data, (long long)0);
+            for (int i = 99; i >= 0; i--) {
+                obs_test_eq(array_stack_pop(stack).data.int_data, (long long)i);
+            }
+            obs_test_true(array_stack_is_empty(stack));
+            array_stack_free(stack);
+        })
+
+        OBS_TEST("Items keep their labels", {
+            ArrayStack stack = array_stack_new("stack");
+            array_stack_push(stack, NEW_NODE(array_stack, "a"));
+            SET_PTR(array_stack_top(stack), "top");
+            obs_test_strcmp(array_stack_pop(stack).ptr, "top");
+            array_stack_free(stack);
+        })
+    })
+
+    OBS_TEST_GROUP("array_stack_from_array && array_stack_push_n", {
+        OBS_TEST("The last item pushed is on top", {
+            ArrayStack stack = array_stack_from_array("stack", DATA_ARRAY(((int[]){1, 2, 3})), 3);
+            array_stack_push_n(stack, DATA_ARRAY(((int[]){4, 5})), 2);
+            obs_test_eq(array_stack_length(stack), 5);
+            for (int i = 5; i >= 1; i--) {
+                obs_test_eq(array_stack_pop(stack).data.int_data, (long long)i);
+            }
+            array_stack_clear(stack);
+            obs_test_eq(stack->capacity, 8);
+            array_stack_free(stack);
+        })
+    })
+
+    OBS_REPORT;
+}
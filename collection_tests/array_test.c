@@ -115,5 +115,77 @@ int main(int argc, char *argv[]) {
         })
     })
 
+    OBS_TEST_GROUP("array_from_array/append_n", {
+        OBS_TEST("From typed and Data arrays", {
+            Array array = array_from_array("1", DATA_ARRAY(((int[]){1, 2, 3})), 3);
+            obs_test_eq(array_length(array), 3);
+            for (int i = 0; i < 3; i++) obs_test_eq(array_at(array, i)->data.int_data, (long long)i + 1);
+            array_free(array);
+
+            Data *data = ((Data[]){{.str_data = "a"}, {.str_data = "b"}});
+            array = array_from_array("2", data_array(data, STRING), 2);
+            obs_test_strcmp(array_at(array, 1)->data.str_data, "b");
+            obs_test_eq(array_at(array, 1)->data_tag, STRING);
+            array_free(array);
+        })
+
+        OBS_TEST("Append grows the array", {
+            Array array = array_new("1", 1);
+            array_set(array, 0, NEW_NODE(array, 1));
+            array_append_n(array, DATA_ARRAY(((double[]){2.5, 3.5})), 2);
+            obs_test_eq(array_length(array), 3);
+            obs_test_eq(array_at(array, 0)->data.int_data, (long long)1);
+            obs_test_eq(array_at(array, 2)->data.flt_data, 3.5);
+            obs_test_eq(array_at(array, 2)->data_tag, FLOAT);
+            array_free(array);
+        })
+    })
+
+    OBS_TEST_GROUP("array_new_soa", {
+        OBS_TEST("Get, set and labels", {
+            Array array = array_new_soa("1", 4, FLOAT);
+            obs_test_eq(array_length(array), 4);
+            obs_test_eq(array_get(array, 3).flt_data, 0.0);
+            obs_test_eq(array_get_tag(array, 3), FLOAT);
+            obs_test_null(array->columns->tags);
+
+            array_set(array, 1, NEW_NODE(array, 2.5));
+            obs_test_null(array->columns->tags);
+            struct _array_data_t node = NEW_NODE(array, 7);
+            node.ptr = "i";
+            array_set(array, 2, node);
+            obs_test_not_null(array->columns->tags);
+            obs_test_eq(array_get(array, 1).flt_data, 2.5);
+            obs_test_eq(array_get(array, 2).int_data, (long long)7);
+            obs_test_eq(array_get_tag(array, 2), INTEGER);
+            obs_test_strcmp(array_get_ptr(array, 2), "i");
+            obs_test_null(array_get_ptr(array, 1));
+
+            array_set_ptr(array, 2, NULL);
+            array_set_ptr(array, 0, "j");
+            obs_test_null(array_get_ptr(array, 2));
+            obs_test_strcmp(array_get_ptr(array, 0), "j");
+
+            // shrinking drops labels past the end
+            array_set_ptr(array, 3, "k");
+            array_resize(array, 3);
+            array_append_n(array, DATA_ARRAY(((double[]){9.5})), 1);
+            obs_test_null(array_get_ptr(array, 3));
+            obs_test_eq(array_get(array, 3).flt_data, 9.5);
+            obs_test_eq(array_get_tag(array, 3), FLOAT);
+            array_free(array);
+        })
+
+        OBS_TEST("Accessors work on normal arrays too", {
+            Array array = array_from_array("1", DATA_ARRAY(((int[]){1, 2})), 2);
+            array_set_ptr(array, 1, "i");
+            obs_test_eq(array_get(array, 1).int_data, (long long)2);
+            obs_test_eq(array_get_tag(array, 1), INTEGER);
+            obs_test_strcmp(array_get_ptr(array, 1), "i");
+            obs_test_strcmp(array_at(array, 1)->ptr, "i");
+            array_free(array);
+        })
+    })
+
     OBS_REPORT;
 }
\ No newline at end of file
@@ -6,6 +6,22 @@
 #include "../include/types/shared_types.h"
 #include <string.h>
 
+// prints the list into `buf` rather than the terminal
+static void dll_render(DLL list, char *buf, size_t capacity) {
+    LLVSink old = llv_set_sink(llv_memory_sink(buf, capacity, NULL));
+    update(1, list);
+    LLVSink sink = llv_set_sink(old);
+    sink->close(sink);
+}
+
+// counts how many nodes a print measures
+static int sized = 0;
+static fn_sizeof_node real_sizeof = NULL;
+static int counting_sizeof(void *n) {
+    sized++;
+    return real_sizeof(n);
+}
+
 int main(int argc, char *argv[]) {
     OBS_SETUP("Doubly Linked List")
 
@@ -352,6 +368,29 @@ int main(int argc, char *argv[]) {
             obs_test_eq(dll_length(list), (int)10);
             dll_free(list);
         })
+
+        OBS_TEST("Length kept through inserts and removes", {
+            DLL list = dll_new("4");
+            long long *items = ((long long[]){1, 2, 3, 4, 5});
+            map_items(list, 5, items, dll, dll_append);
+            dll_insert_before(list, NEW_NODE(dll, 0), list->head->next);
+            dll_insert_after(list, NEW_NODE(dll, 6), list->tail);
+            obs_test_eq(dll_length(list), (int)7);
+
+            dll_free_node(dll_remove_node(list, list->head->next->next));
+            dll_free_node(dll_remove_node(list, list->tail));
+            obs_test_eq(dll_length(list), (int)5);
+
+            // removing something that isn't in the list doesn't change it
+            DLL_Node stray = NEW_NODE(dll, 9);
+            obs_test_null(dll_remove_node(list, stray));
+            obs_test_eq(dll_length(list), (int)5);
+            dll_free_node(stray);
+
+            dll_clear(list);
+            obs_test_eq(dll_length(list), (int)0);
+            dll_free(list);
+        })
     })
 
     OBS_TEST_GROUP("DLL_push/pop", {
@@ -412,5 +451,175 @@ int main(int argc, char *argv[]) {
         })
     })
 
+    OBS_TEST_GROUP("DLL_from_array/append_n", {
+        OBS_TEST("From typed and Data arrays", {
+            DLL list = dll_from_array("1", DATA_ARRAY(((int[]){1, 2, 3})), 3);
+            test_list(list, ((long long[]){1, 2, 3}), dll);
+            obs_test_null(list->head->prev);
+            obs_test_eq(list->tail->prev->prev, list->head);
+            dll_free(list);
+
+            Data *data = ((Data[]){{.str_data = "a"}, {.str_data = "b"}});
+            list = dll_from_array("2", data_array(data, STRING), 2);
+            test_strcmp_fakenode(list, ((char*[]){"a", "b"}));
+            dll_free(list);
+        })
+
+        OBS_TEST("Append onto existing nodes", {
+            DLL list = dll_new("1");
+            dll_append(list, NEW_NODE(dll, 1));
+            dll_append_n(list, DATA_ARRAY(((long long[]){2, 3, 4})), 3);
+            dll_append(list, NEW_NODE(dll, 5));
+            test_list(list, ((long long[]){1, 2, 3, 4, 5}), dll);
+
+            // walk back from the tail
+            long long expected = 5;
+            for (DLL_Node n = list->tail; n != NULL; n = n->prev) {
+                obs_test_eq(n->data.int_data, expected--);
+            }
+            obs_test_eq(expected, (long long)0);
+
+            dll_free_node(dll_remove_node(list, list->head->next));
+            test_list(list, ((long long[]){1, 3, 4, 5}), dll);
+            dll_free(list);
+        })
+    })
+
+    OBS_TEST_GROUP("DLL_sort", {
+        OBS_TEST("Sort numbers keeps prev right", {
+            DLL list = dll_from_array("1", DATA_ARRAY(((int[]){5, 3, 8, 1, 9, 2, 7, 4, 6, 0})), 10);
+            dll_sort(list, NULL);
+            test_list(list, ((long long[]){0, 1, 2, 3, 4, 5, 6, 7, 8, 9}), dll);
+            obs_test_null(list->head->prev);
+            long long expected = 9;
+            for (DLL_Node n = list->tail; n != NULL; n = n->prev) {
+                obs_test_eq(n->data.int_data, expected--);
+            }
+            obs_test_eq(expected, (long long)-1);
+            dll_free(list);
+        })
+
+        OBS_TEST("Sort strings", {
+            DLL list = dll_from_array("1", DATA_ARRAY(((char*[]){"pear", "apple", "fig"})), 3);
+            dll_sort(list, NULL);
+            test_strcmp_fakenode(list, ((char*[]){"apple", "fig", "pear"}));
+            obs_test_strcmp(list->tail->prev->data.str_data, "fig");
+            dll_free(list);
+        })
+    })
+
+    OBS_TEST_GROUP("DLL_concat/splice/split_at", {
+        OBS_TEST("Insert after the middle keeps prev right", {
+            DLL list = dll_from_array("1", DATA_ARRAY(((int[]){1, 3})), 2);
+            dll_insert_after(list, NEW_NODE(dll, 2), list->head);
+            test_list(list, ((long long[]){1, 2, 3}), dll);
+            obs_test_eq(list->tail->prev->data.int_data, (long long)2);
+            dll_free(list);
+        })
+
+        OBS_TEST("Concat and splice", {
+            DLL list = dll_from_array("1", DATA_ARRAY(((int[]){1, 4})), 2);
+            DLL other = dll_from_array("2", DATA_ARRAY(((int[]){2, 3})), 2);
+            dll_splice(list, list->head, other);
+            test_empty_list(other, dll);
+            dll_append_n(other, DATA_ARRAY(((int[]){5, 6})), 2);
+            dll_concat(list, other);
+            dll_append_n(other, DATA_ARRAY(((int[]){0})), 1);
+            dll_splice(list, NULL, other);
+            test_list(list, ((long long[]){0, 1, 2, 3, 4, 5, 6}), dll);
+
+            long long expected = 6;
+            for (DLL_Node n = list->tail; n != NULL; n = n->prev) {
+                obs_test_eq(n->data.int_data, expected--);
+            }
+            obs_test_eq(expected, (long long)-1);
+            dll_free(list);
+            dll_free(other);
+        })
+
+        OBS_TEST("Split at", {
+            DLL list = dll_from_array("1", DATA_ARRAY(((int[]){1, 2, 3, 4, 5})), 5);
+            DLL_Node focus = list->tail;
+            dll_set_focus(list, &focus);
+            DLL rest = dll_split_at(list, 3, "2");
+            test_list(list, ((long long[]){1, 2, 3}), dll);
+            test_list(rest, ((long long[]){4, 5}), dll);
+            obs_test_null(list->tail->next);
+            obs_test_null(rest->head->prev);
+            obs_test_eq(rest->tail->prev, rest->head);
+            // the focus went with the other half
+            obs_test_null(list->focus);
+            dll_free(list);
+            dll_free(rest);
+        })
+    })
+
+    OBS_TEST_GROUP("dll_set_focus", {
+        OBS_TEST("Removing or clearing the focus prints from the head and tail", {
+            static char expected[4096];
+            static char actual[4096];
+            llv_set_headless(true);
+            DLL list = dll_from_array("focus", DATA_ARRAY(((int[]){1, 2, 3, 4})), 4);
+            DLL_Node focus = list->head->next;
+            dll_set_focus(list, &focus);
+            DLL_Node removed = dll_remove_node(list, focus);
+            obs_test_null(list->focus);
+            dll_set_focus(list, NULL);
+            dll_render(list, expected, sizeof(expected));
+            obs_test_neq((int)strlen(expected), 0);
+            dll_render(list, actual, sizeof(actual));
+            obs_test_strcmp(actual, expected);
+
+            // a node of some other list is left alone
+            DLL other = dll_from_array("other", DATA_ARRAY(((int[]){5})), 1);
+            focus = list->head;
+            dll_set_focus(list, &focus);
+            obs_test_null(dll_remove_node(list, other->head));
+            obs_test_eq(list->focus, &focus);
+
+            dll_free_node(dll_pop(list));
+            obs_test_null(list->focus);
+
+            dll_set_focus(list, &focus);
+            dll_clear(list);
+            obs_test_null(list->focus);
+
+            dll_free_node(removed);
+            dll_free(list);
+            dll_free(other);
+            llv_set_headless(false);
+        })
+
+        OBS_TEST("A deep focus only looks at the nodes around it", {
+            static char actual[4096];
+            llv_set_headless(true);
+            int len = 500000;
+            int *items = malloc(sizeof(int) * len);
+            for (int i = 0; i < len; i++) items[i] = i;
+            DLL list = dll_from_array("deep", DATA_ARRAY(items), len);
+            free(items);
+
+            DLL_Node focus = list->tail;
+            for (int i = 0; i < 1000; i++) focus = focus->prev;
+            // cutting the list off just behind the window stops any walk to the head
+            DLL_Node cut = focus;
+            for (int i = 0; i < 200; i++) cut = cut->prev;
+            DLL_Node before_cut = cut->prev;
+            cut->prev = NULL;
+
+            sized = 0;
+            real_sizeof = list->parent.get_sizeof;
+            list->parent.get_sizeof = counting_sizeof;
+            dll_set_focus(list, &focus);
+            dll_render(list, actual, sizeof(actual));
+            obs_test_not_null(strstr(actual, "498999"));
+            obs_test_lt(sized, 200);
+
+            cut->prev = before_cut;
+            dll_free(list);
+            llv_set_headless(false);
+        })
+    })
+
     OBS_REPORT
 }
@@ -0,0 +1,100 @@
+#include "../include/collections/intrusive.h"
+#include "../lib/obsidian.h"
+#include "../include/llv.h"
+#include "collection_test_helper.h"
+#include <string.h>
+#include <stdint.h>
+
+struct item {
+    const char *name;
+    struct item *next;
+    float weight;
+    struct item *prev;
+    unsigned long long id;
+};
+
+struct pkt {
+    struct pkt *next;
+    uint16_t port;
+    uint8_t ttl;
+    int8_t hops;
+};
+
+int main(int argc, char *argv[]) {
+    OBS_SETUP("Intrusive List")
+
+    OBS_TEST_GROUP("LLV_INTRUSIVE_LL && LLV_INTRUSIVE_DLL", {
+        OBS_TEST("Offsets and value types come from the struct", {
+            IntrusiveDesc desc = LLV_INTRUSIVE_DLL(struct item, next, prev, weight);
+            obs_test_eq((int)desc.next_offset, (int)offsetof(struct item, next));
+            obs_test_eq((int)desc.prev_offset, (int)offsetof(struct item, prev));
+            obs_test_eq((int)desc.value_offset, (int)offsetof(struct item, weight));
+            obs_test_eq(desc.value_kind, DATA_ARRAY_FLOAT);
+            obs_test_eq(desc.value_tag, FLOAT);
+            obs_test_eq((int)desc.label_offset, (int)LLV_NO_OFFSET);
+            obs_test_null(desc.value_read);
+
+            desc = LLV_INTRUSIVE_LL(struct item, next, id);
+            obs_test_eq((int)desc.prev_offset, (int)LLV_NO_OFFSET);
+            obs_test_eq(desc.value_kind, DATA_ARRAY_UNSIGNED_LONG_LONG);
+            obs_test_eq(desc.value_tag, INTEGER);
+
+            desc = LLV_INTRUSIVE_LL(struct item, next, name);
+            obs_test_eq(desc.value_kind, DATA_ARRAY_STR);
+            obs_test_eq(desc.value_tag, STRING);
+        })
+
+        OBS_TEST("Fixed width integer fields", {
+            struct pkt pkt = {0};
+            pkt.port = 65535;
+            pkt.ttl = 200;
+            pkt.hops = -3;
+            IntrusiveDesc desc = LLV_INTRUSIVE_LL(struct pkt, next, port);
+            obs_test_eq(desc.value_kind, DATA_ARRAY_UNSIGNED_SHORT);
+            obs_test_eq(desc.value_tag, INTEGER);
+            DataArray value = data_array(NULL, INTEGER);
+            value.items = (char*)&pkt + desc.value_offset;
+            value.kind = desc.value_kind;
+            obs_test_eq(data_array_at(value, 0).int_data, (long long)65535);
+
+            desc = LLV_INTRUSIVE_LL(struct pkt, next, ttl);
+            obs_test_eq(desc.value_kind, DATA_ARRAY_UNSIGNED_CHAR);
+            value.items = (char*)&pkt + desc.value_offset;
+            value.kind = desc.value_kind;
+            obs_test_eq(data_array_at(value, 0).int_data, (long long)200);
+
+            desc = LLV_INTRUSIVE_LL(struct pkt, next, hops);
+            obs_test_eq(desc.value_kind, DATA_ARRAY_SIGNED_CHAR);
+            value.items = (char*)&pkt + desc.value_offset;
+            value.kind = desc.value_kind;
+            obs_test_eq(data_array_at(value, 0).int_data, (long long)-3);
+        })
+    })
+
+    OBS_TEST_GROUP("intrusive_new", {
+        OBS_TEST("Reads the head every time rather than copying", {
+            struct item items[3] = {0};
+            struct item *head = NULL;
+            IntrusiveList list = intrusive_new("items", &head,
+                                               LLV_INTRUSIVE_LL(struct item, next, id));
+            obs_test_strcmp(list->parent.name, "items");
+            obs_test_null(list->tail);
+            obs_test_eq(intrusive_length(list), 0);
+
+            head = &items[0];
+            items[0].next = &items[1];
+            obs_test_eq(intrusive_length(list), 2);
+            items[1].next = &items[2];
+            obs_test_eq(intrusive_length(list), 3);
+            head = &items[2];
+            obs_test_eq(intrusive_length(list), 1);
+
+            struct item *tail = &items[2];
+            intrusive_set_tail(list, &tail);
+            obs_test_eq(list->tail, (void*)&tail);
+            intrusive_free(list);
+        })
+    })
+
+    OBS_REPORT;
+}
@@ -247,5 +247,115 @@ int main(int argc, char *argv[]) {
         })
     })
 
+    OBS_TEST_GROUP("List_from_array/append_n", {
+        OBS_TEST("From typed and Data arrays", {
+            List list = list_from_array("1", DATA_ARRAY(((int[]){1, 2, 3})), 3);
+            obs_test_eq(list_length(list), 3);
+            obs_test_eq(list_capacity(list), 3);
+            dynlist_test(((long long[]){1, 2, 3}), list);
+            obs_test_eq(list_at(list, 2)->data.int_data, (long long)3);
+            obs_test_null(list_at(list, 3));
+            list_free(list);
+
+            Data *data = ((Data[]){{.flt_data = 1.5}, {.flt_data = 2.5}});
+            list = list_from_array("2", data_array(data, FLOAT), 2);
+            dynlist_test(((double[]){1.5, 2.5}), list);
+            obs_test_eq(list_at(list, 0)->data_tag, FLOAT);
+            list_free(list);
+        })
+
+        OBS_TEST("Append onto existing items", {
+            List list = list_new("1");
+            list_push_back(list, NEW_NODE(list, 1));
+            list_append_n(list, DATA_ARRAY(((long long[]){2, 3, 4, 5})), 4);
+            list_push_back(list, NEW_NODE(list, 6));
+            obs_test_eq(list_length(list), 6);
+            dynlist_test(((long long[]){1, 2, 3, 4, 5, 6}), list);
+            list_free(list);
+        })
+    })
+
+    OBS_TEST_GROUP("List insert/remove", {
+        OBS_TEST("Insert before and after keep every element", {
+            List list = list_from_array("1", DATA_ARRAY(((int[]){1, 3, 5})), 3);
+            list_insert_before(list, 1, NEW_NODE(list, 2));
+            list_insert_after(list, 2, NEW_NODE(list, 4));
+            list_insert_before(list, 0, NEW_NODE(list, 0));
+            obs_test_eq(list_length(list), 6);
+            dynlist_test(((long long[]){0, 1, 2, 3, 4, 5}), list);
+            list_remove(list, 2);
+            list_remove(list, 4);
+            dynlist_test(((long long[]){0, 1, 3, 4}), list);
+            list_free(list);
+        })
+    })
+
+    OBS_TEST_GROUP("List_new_soa", {
+        OBS_TEST("Same answers as the normal layout", {
+            List list = list_new("1");
+            List soa = list_new_soa("2", INTEGER);
+            srand(42);
+            char **labels = ((char*[]){"a", "b", "c"});
+            for (int step = 0; step < 2000; step++) {
+                int len = list_length(list);
+                int index = len > 0 ? rand() % len : 0;
+                struct _list_data_t node = NEW_NODE(list, step);
+                if (step % 7 == 0) node = NEW_NODE(list, step * 0.5);
+                if (step % 5 == 0) node.ptr = labels[step % 3];
+
+                switch (len == 0 ? 0 : rand() % 5) {
+                    case 0: {
+                        list_push_back(list, node);
+                        list_push_back(soa, node);
+                    } break;
+                    case 1: {
+                        list_insert_after(list, index, node);
+                        list_insert_after(soa, index, node);
+                    } break;
+                    case 2: {
+                        list_insert_before(list, index, node);
+                        list_insert_before(soa, index, node);
+                    } break;
+                    case 3: {
+                        list_remove(list, index);
+                        list_remove(soa, index);
+                    } break;
+                    case 4: {
+                        list_set_ptr(list, index, step % 2 ? NULL : labels[0]);
+                        list_set_ptr(soa, index, step % 2 ? NULL : labels[0]);
+                    } break;
+                }
+            }
+
+            obs_test_eq(list_length(soa), list_length(list));
+            for (int i = 0; i < list_length(list); i++) {
+                obs_test_eq(list_get_tag(soa, i), list_at(list, i)->data_tag);
+                obs_test_eq(list_get(soa, i).int_data, list_at(list, i)->data.int_data);
+                obs_test_eq(list_get_ptr(soa, i), list_at(list, i)->ptr);
+            }
+            list_free(list);
+            list_free(soa);
+        })
+
+        OBS_TEST("The tag column only exists once types are mixed", {
+            List list = list_new_soa("1", INTEGER);
+            list_append_n(list, DATA_ARRAY(((int[]){1, 2, 3})), 3);
+            obs_test_null(list->columns->tags);
+            obs_test_null(list->data);
+            list_push_back(list, NEW_NODE(list, "four"));
+            obs_test_not_null(list->columns->tags);
+            obs_test_eq(list_get_tag(list, 2), INTEGER);
+            obs_test_eq(list_get_tag(list, 3), STRING);
+            obs_test_strcmp(list_get(list, 3).str_data, "four");
+
+            list_clear(list, true);
+            obs_test_eq(list_length(list), 0);
+            list_push_back(list, NEW_NODE(list, 5));
+            obs_test_eq(list_get(list, 0).int_data, (long long)5);
+            obs_test_null(list_get_ptr(list, 0));
+            list_free(list);
+        })
+    })
+
     OBS_REPORT
 }
@@ -6,6 +6,11 @@
 #include "../include/types/shared_types.h"
 #include <string.h>
 
+// orders strings by their first letter only, for testing stability
+static int compare_first_char(Data a, TypeTag a_tag, Data b, TypeTag b_tag) {
+    return a.str_data[0] - b.str_data[0];
+}
+
 int main(int argc, char *argv[]) {
     OBS_SETUP("Linked List")
 
@@ -352,6 +357,29 @@ int main(int argc, char *argv[]) {
             obs_test_eq(ll_length(list), (int)10);
             ll_free(list);
         })
+
+        OBS_TEST("Length kept through inserts and removes", {
+            LL list = ll_new("4");
+            long long *items = ((long long[]){1, 2, 3, 4, 5});
+            map_items(list, 5, items, ll, ll_append);
+            ll_insert_before(list, NEW_NODE(ll, 0), list->head->next);
+            ll_insert_after(list, NEW_NODE(ll, 6), list->tail);
+            obs_test_eq(ll_length(list), (int)7);
+
+            ll_free_node(ll_remove_node(list, list->head->next->next));
+            ll_free_node(ll_remove_node(list, list->tail));
+            obs_test_eq(ll_length(list), (int)5);
+
+            // removing something that isn't in the list doesn't change it
+            LL_Node stray = NEW_NODE(ll, 9);
+            obs_test_null(ll_remove_node(list, stray));
+            obs_test_eq(ll_length(list), (int)5);
+            ll_free_node(stray);
+
+            ll_clear(list);
+            obs_test_eq(ll_length(list), (int)0);
+            ll_free(list);
+        })
     })
 
     OBS_TEST_GROUP("LL_push/pop", {
@@ -412,5 +440,221 @@ int main(int argc, char *argv[]) {
         })
     })
 
+    OBS_TEST_GROUP("LL_cursor/remove_after", {
+        OBS_TEST("Remove after", {
+            LL list = ll_new("1");
+            obs_test_null(ll_remove_after(list, NULL));
+            long long *elements = ((long long[]){1, 2, 3, 4});
+            map_items(list, 4, elements, ll, ll_append);
+
+            LL_Node n = ll_remove_after(list, NULL);
+            obs_test_eq(n->data.int_data, (long long)1);
+            ll_free_node(n);
+            n = ll_remove_after(list, list->head->next);
+            obs_test_eq(n->data.int_data, (long long)4);
+            ll_free_node(n);
+            obs_test_eq(list->tail->data.int_data, (long long)3);
+            obs_test_null(ll_remove_after(list, list->tail));
+            test_list(list, ((long long[]){2, 3}), ll);
+            ll_free(list);
+        })
+
+        OBS_TEST("Remove odd nodes with a cursor", {
+            LL list = ll_new("1");
+            long long *elements = ((long long[]){1, 2, 5, 9, 2, 4, 5});
+            map_items(list, 7, elements, ll, ll_append);
+            for (LL_Cursor cursor = ll_cursor(list); cursor.cur != NULL;) {
+                if (cursor.cur->data.int_data % 2 != 0) {
+                    ll_free_node(ll_cursor_remove(&cursor));
+                } else {
+                    ll_cursor_next(&cursor);
+                }
+            }
+            test_list(list, ((long long[]){2, 2, 4}), ll);
+            obs_test_eq(list->tail->data.int_data, (long long)4);
+
+            // and removing everything leaves an empty list
+            LL_Cursor cursor = ll_cursor(list);
+            while (cursor.cur != NULL) ll_free_node(ll_cursor_remove(&cursor));
+            obs_test_null(ll_cursor_remove(&cursor));
+            test_empty_list(list, ll);
+            ll_free(list);
+        })
+
+        OBS_TEST("Insert before with a cursor", {
+            LL list = ll_new("1");
+            LL_Cursor cursor = ll_cursor(list);
+            ll_cursor_insert_before(&cursor, NEW_NODE(ll, 3));
+            obs_test_eq(list->head, list->tail);
+
+            cursor = ll_cursor(list);
+            ll_cursor_insert_before(&cursor, NEW_NODE(ll, 1));
+            obs_test_eq(cursor.cur->data.int_data, (long long)3);
+            ll_cursor_insert_before(&cursor, NEW_NODE(ll, 2));
+            ll_cursor_next(&cursor);
+            obs_test_null(cursor.cur);
+            ll_cursor_insert_before(&cursor, NEW_NODE(ll, 4));
+            test_list(list, ((long long[]){1, 2, 3, 4}), ll);
+            obs_test_eq(list->tail->data.int_data, (long long)4);
+            ll_free(list);
+        })
+    })
+
+    OBS_TEST_GROUP("LL_from_array/append_n/push_n", {
+        OBS_TEST("From typed and Data arrays", {
+            LL list = ll_from_array("1", DATA_ARRAY(((int[]){1, 2, 3})), 3);
+            test_list(list, ((long long[]){1, 2, 3}), ll);
+            obs_test_eq(list->tail->data.int_data, (long long)3);
+            obs_test_eq(list->head->data_tag, INTEGER);
+            ll_free(list);
+
+            Data *data = ((Data[]){{.flt_data = 1.5}, {.flt_data = 2.5}});
+            list = ll_from_array("2", data_array(data, FLOAT), 2);
+            test_list(list, ((double[]){1.5, 2.5}), ll);
+            ll_free(list);
+
+            list = ll_from_array("3", DATA_ARRAY(((char*[]){"a", "b"})), 0);
+            test_empty_list(list, ll);
+            ll_free(list);
+        })
+
+        OBS_TEST("Append and push onto existing nodes", {
+            LL list = ll_new("1");
+            ll_append(list, NEW_NODE(ll, 3));
+            ll_append_n(list, DATA_ARRAY(((long long[]){4, 5})), 2);
+            ll_push_n(list, DATA_ARRAY(((long long[]){2, 1})), 2);
+            ll_append(list, NEW_NODE(ll, 6));
+            test_list(list, ((long long[]){1, 2, 3, 4, 5, 6}), ll);
+            obs_test_eq(list->tail->data.int_data, (long long)6);
+
+            // bulk nodes can still be removed one at a time
+            ll_free_node(ll_remove_node(list, list->head->next));
+            ll_free_node(ll_pop(list));
+            test_list(list, ((long long[]){3, 4, 5, 6}), ll);
+
+            LL empty = ll_new("2");
+            ll_push_n(empty, DATA_ARRAY(((long long[]){2, 1})), 2);
+            test_list(empty, ((long long[]){1, 2}), ll);
+            obs_test_eq(empty->tail->data.int_data, (long long)2);
+            ll_free(empty);
+            ll_free(list);
+        })
+
+        OBS_TEST("Big arrays", {
+            int len = 100000;
+            long long *items = malloc(sizeof(long long) * len);
+            for (int i = 0; i < len; i++) items[i] = i;
+            LL list = ll_from_array("1", DATA_ARRAY(items), len);
+            test_list(list, items, ll);
+            obs_test_eq(list->tail->data.int_data, (long long)(len - 1));
+            ll_free(list);
+            free(items);
+        })
+    })
+
+    OBS_TEST_GROUP("LL_sort", {
+        OBS_TEST("Sort empty and single lists", {
+            LL list = ll_new("1");
+            ll_sort(list, NULL);
+            test_empty_list(list, ll);
+            ll_append(list, NEW_NODE(ll, 1));
+            ll_sort(list, NULL);
+            test_list(list, ((long long[]){1}), ll);
+            obs_test_eq(list->tail, list->head);
+            ll_free(list);
+        })
+
+        OBS_TEST("Sort numbers", {
+            LL list = ll_from_array("1", DATA_ARRAY(((int[]){5, 3, 8, 1, 9, 2, 7, 4, 6, 0, 3})), 11);
+            ll_sort(list, NULL);
+            test_list(list, ((long long[]){0, 1, 2, 3, 3, 4, 5, 6, 7, 8, 9}), ll);
+            obs_test_eq(list->tail->data.int_data, (long long)9);
+            obs_test_null(list->tail->next);
+            ll_free(list);
+
+            // integers and floats sort together
+            list = ll_new("2");
+            ll_append(list, NEW_NODE(ll, 2));
+            ll_append(list, NEW_NODE(ll, 1.5));
+            ll_append(list, NEW_NODE(ll, -1));
+            ll_sort(list, NULL);
+            obs_test_eq(list->head->data.int_data, (long long)-1);
+            obs_test_eq(list->head->next->data.flt_data, 1.5);
+            ll_free(list);
+        })
+
+        OBS_TEST("Sort is stable", {
+            char **items = ((char*[]){"b1", "a1", "b2", "a2", "c1", "a3"});
+            LL list = ll_from_array("1", DATA_ARRAY(items), 6);
+            ll_sort(list, compare_first_char);
+            test_strcmp_fakenode(list, ((char*[]){"a1", "a2", "a3", "b1", "b2", "c1"}));
+            ll_free(list);
+        })
+
+        OBS_TEST("Sort big lists", {
+            int len = 10000;
+            int *items = malloc(sizeof(int) * len);
+            for (int i = 0; i < len; i++) items[i] = (i * 7919) % len;
+            LL list = ll_from_array("1", DATA_ARRAY(items), len);
+            ll_sort(list, NULL);
+            int i = 0;
+            for (LL_Node n = list->head; n != NULL; n = n->next, i++) {
+                obs_test_eq(n->data.int_data, (long long)i);
+            }
+            obs_test_eq(i, len);
+            ll_free(list);
+            free(items);
+        })
+    })
+
+    OBS_TEST_GROUP("LL_concat/splice/split_at", {
+        OBS_TEST("Concat and splice", {
+            LL list = ll_from_array("1", DATA_ARRAY(((int[]){1, 2})), 2);
+            LL other = ll_from_array("2", DATA_ARRAY(((int[]){3, 4})), 2);
+            ll_concat(list, other);
+            test_list(list, ((long long[]){1, 2, 3, 4}), ll);
+            obs_test_eq(list->tail->data.int_data, (long long)4);
+            test_empty_list(other, ll);
+
+            // concat of an empty list does nothing and onto one takes it all
+            ll_concat(list, other);
+            obs_test_eq(ll_length(list), 4);
+            ll_concat(other, list);
+            test_list(other, ((long long[]){1, 2, 3, 4}), ll);
+            test_empty_list(list, ll);
+
+            ll_append_n(list, DATA_ARRAY(((int[]){0, 5})), 2);
+            ll_splice(other, NULL, list);
+            ll_append_n(list, DATA_ARRAY(((int[]){6, 7})), 2);
+            ll_splice(other, other->head->next->next, list);
+            test_list(other, ((long long[]){0, 5, 1, 6, 7, 2, 3, 4}), ll);
+            obs_test_eq(other->tail->data.int_data, (long long)4);
+            ll_free(list);
+            ll_free(other);
+        })
+
+        OBS_TEST("Split at", {
+            LL list = ll_from_array("1", DATA_ARRAY(((int[]){1, 2, 3, 4, 5})), 5);
+            LL rest = ll_split_at(list, 2, "2");
+            test_list(list, ((long long[]){1, 2}), ll);
+            obs_test_eq(list->tail->data.int_data, (long long)2);
+            obs_test_null(list->tail->next);
+            test_list(rest, ((long long[]){3, 4, 5}), ll);
+            obs_test_eq(rest->tail->data.int_data, (long long)5);
+            obs_test_strcmp(rest->parent.name, "2");
+
+            // past the end leaves everything and at 0 takes everything
+            LL none = ll_split_at(list, 2, "3");
+            test_empty_list(none, ll);
+            LL all = ll_split_at(rest, 0, "4");
+            test_empty_list(rest, ll);
+            test_list(all, ((long long[]){3, 4, 5}), ll);
+            ll_free(list);
+            ll_free(rest);
+            ll_free(none);
+            ll_free(all);
+        })
+    })
+
     OBS_REPORT
 }
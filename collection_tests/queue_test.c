@@ -145,5 +145,20 @@ int main(int argc, char *argv[]) {
         })
     })
 
+    OBS_TEST_GROUP("Queue from_array/enqueue_n", {
+        OBS_TEST("Dequeues in array order", {
+            Queue queue = queue_from_array("1", DATA_ARRAY(((int[]){1, 2})), 2);
+            queue_enqueue_n(queue, DATA_ARRAY(((int[]){3, 4})), 2);
+            obs_test_eq(queue_length(queue), 4);
+            for (int i = 1; i <= 4; i++) {
+                QueueNode n = queue_dequeue(queue);
+                obs_test_eq(n->data.int_data, (long long)i);
+                queue_free_node(n);
+            }
+            test_empty_list(queue, queue);
+            queue_free(queue);
+        })
+    })
+
     OBS_REPORT
 }
\ No newline at end of file
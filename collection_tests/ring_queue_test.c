@@ -0,0 +1,112 @@
+#include "../include/collections/ring_queue.h"
+#include "../lib/obsidian.h"
+#include "../include/llv.h"
+#include "collection_test_helper.h"
+#include "../include/types/collection_skeleton.h"
+#include "../include/types/shared_types.h"
+#include <string.h>
+
+int main(int argc, char *argv[]) {
+    OBS_SETUP("Ring Queue")
+
+    OBS_TEST_GROUP("ring_queue_new && ring_queue_new_node", {
+        OBS_TEST("Create queue and test properties", {
+            RingQueue queue = ring_queue_new("1");
+            obs_test_strcmp(queue->parent.name, "1");
+            obs_test_eq(ring_queue_length(queue), 0);
+            obs_test_true(ring_queue_is_empty(queue));
+            obs_test_null(ring_queue_front(queue));
+            ring_queue_free(queue);
+        })
+
+        OBS_TEST("Create node using generic macros", {
+            struct _ring_queue_data_t node = NEW_NODE(ring_queue, 4);
+            obs_test_eq(node.data_tag, INTEGER);
+            obs_test_null(node.ptr);
+            obs_test_eq(node.data.int_data, (long long)4);
+
+            node = NEW_NODE(ring_queue, "Hello");
+            obs_test_eq(node.data_tag, STRING);
+            obs_test_strcmp(node.data.str_data, "Hello");
+        })
+    })
+
+    OBS_TEST_GROUP("ring_queue_enqueue && ring_queue_dequeue", {
+        OBS_TEST("First in first out", {
+            RingQueue queue = ring_queue_new("queue");
+            for (int i = 0; i < 5; i++) ring_queue_enqueue(queue, NEW_NODE(ring_queue, i));
+            obs_test_eq(ring_queue_length(queue), 5);
+            obs_test_eq(ring_queue_front(queue)->data.int_data, (long long)0);
+            for (int i = 0; i < 5; i++) {
+                obs_test_eq(ring_queue_dequeue(queue).data.int_data, (long long)i);
+            }
+            obs_test_true(ring_queue_is_empty(queue));
+            ring_queue_free(queue);
+        })
+
+        OBS_TEST("Wraps around without growing", {
+            RingQueue queue = ring_queue_new("queue");
+            ring_queue_reserve(queue, 8);
+            obs_test_eq(queue->capacity, 8);
+            for (int i = 0; i < 6; i++) ring_queue_enqueue(queue, NEW_NODE(ring_queue, i));
+            for (int i = 0; i < 4; i++) ring_queue_dequeue(queue);
+            for (int i = 6; i < 12; i++) ring_queue_enqueue(queue, NEW_NODE(ring_queue, i));
+
+            // 4..11 with the front at slot 4 and the back wrapped to slot 3
+            obs_test_eq(queue->capacity, 8);
+            obs_test_eq(queue->head, 4);
+            for (int i = 0; i < 8; i++) {
+                obs_test_eq(ring_queue_at(queue, i)->data.int_data, (long long)(i + 4));
+            }
+            obs_test_null(ring_queue_at(queue, 8));
+            ring_queue_free(queue);
+        })
+
+        OBS_TEST("Growing keeps the order of wrapped items", {
+            RingQueue queue = ring_queue_new("queue");
+            for (int i = 0; i < 8; i++) ring_queue_enqueue(queue, NEW_NODE(ring_queue, i));
+            for (int i = 0; i < 5; i++) ring_queue_dequeue(queue);
+            for (int i = 8; i < 100; i++) ring_queue_enqueue(queue, NEW_NODE(ring_queue, i));
+
+            obs_test_eq(ring_queue_length(queue), 95);
+            obs_test_eq(queue->capacity, 128);
+            for (int i = 5; i < 100; i++) {
+                obs_test_eq(ring_queue_dequeue(queue).data.int_data, (long long)i);
+            }
+            ring_queue_free(queue);
+        })
+
+        OBS_TEST("Items keep their labels", {
+            RingQueue queue = ring_queue_new("queue");
+            ring_queue_enqueue(queue, NEW_NODE(ring_queue, 1));
+            SET_PTR(ring_queue_front(queue), "front");
+            obs_test_strcmp(ring_queue_dequeue(queue).ptr, "front");
+            ring_queue_free(queue);
+        })
+    })
+
+    OBS_TEST_GROUP("ring_queue_from_array && ring_queue_enqueue_n", {
+        OBS_TEST("Bulk enqueue goes to the back in order", {
+            RingQueue queue = ring_queue_from_array("queue", DATA_ARRAY(((int[]){1, 2, 3})), 3);
+            ring_queue_dequeue(queue);
+            ring_queue_enqueue_n(queue, DATA_ARRAY(((double[]){4.5, 5.5})), 2);
+            obs_test_eq(ring_queue_length(queue), 4);
+            obs_test_eq(ring_queue_dequeue(queue).data.int_data, (long long)2);
+            obs_test_eq(ring_queue_dequeue(queue).data.int_data, (long long)3);
+            struct _ring_queue_data_t node = ring_queue_dequeue(queue);
+            obs_test_eq(node.data_tag, FLOAT);
+            obs_test_eq(node.data.flt_data, 4.5);
+            ring_queue_free(queue);
+        })
+
+        OBS_TEST("Clear keeps the buffer", {
+            RingQueue queue = ring_queue_from_array("queue", DATA_ARRAY(((int[]){1, 2, 3})), 3);
+            ring_queue_clear(queue);
+            obs_test_true(ring_queue_is_empty(queue));
+            obs_test_eq(queue->capacity, 8);
+            ring_queue_free(queue);
+        })
+    })
+
+    OBS_REPORT;
+}
@@ -145,5 +145,20 @@ int main(int argc, char *argv[]) {
         })
     })
 
+    OBS_TEST_GROUP("Stack from_array/push_n", {
+        OBS_TEST("Pops in reverse array order", {
+            Stack stack = stack_from_array("1", DATA_ARRAY(((int[]){1, 2})), 2);
+            stack_push_n(stack, DATA_ARRAY(((int[]){3, 4})), 2);
+            obs_test_eq(stack_length(stack), 4);
+            for (int i = 4; i >= 1; i--) {
+                StackNode n = stack_pop(stack);
+                obs_test_eq(n->data.int_data, (long long)i);
+                stack_free_node(n);
+            }
+            test_empty_list(stack, stack);
+            stack_free(stack);
+        })
+    })
+
     OBS_REPORT
 }
\ No newline at end of file
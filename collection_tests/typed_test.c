@@ -0,0 +1,128 @@
+#include "../include/collections/typed.h"
+#include "../lib/obsidian.h"
+#include "../include/llv.h"
+#include "collection_test_helper.h"
+#include <string.h>
+
+LLV_DEFINE_ARRAY(str)
+LLV_DEFINE_LIST(int)
+LLV_DEFINE_LL(double)
+
+// a type of our own
+#define LLV_TYPED_u8_TYPE unsigned char
+#define LLV_TYPED_u8_TAG INTEGER
+#define LLV_TYPED_u8_DATA(value) data_int(value)
+LLV_DEFINE_LIST(u8)
+
+int main(int argc, char *argv[]) {
+    OBS_SETUP("Typed Collections")
+
+    OBS_TEST_GROUP("LLV_DEFINE_ARRAY", {
+        OBS_TEST("Elements start zeroed and resize keeps them", {
+            Array_str array = array_str_new("array", 3);
+            obs_test_strcmp(array->parent.name, "array");
+            obs_test_eq(array_str_length(array), 3);
+            for (int i = 0; i < 3; i++) obs_test_null(*array_str_at(array, i));
+
+            *array_str_at(array, 1) = "b";
+            array_str_resize(array, 5);
+            obs_test_strcmp(*array_str_at(array, 1), "b");
+            obs_test_null(*array_str_at(array, 4));
+            obs_test_eq(array_str_read(array->data, 1).str_data, array->data[1]);
+            array_str_free(array);
+        })
+    })
+
+    OBS_TEST_GROUP("LLV_DEFINE_LIST", {
+        OBS_TEST("Values are stored unboxed", {
+            List_int list = list_int_new("list");
+            for (int i = 0; i < 100; i++) list_int_push_back(list, i * 3);
+            obs_test_eq(list_int_length(list), 100);
+            obs_test_gte(list->max_len, 100);
+            for (int i = 0; i < 100; i++) obs_test_eq(list->data[i], i * 3);
+
+            *list_int_at(list, 5) = -1;
+            obs_test_eq(list_int_read(list->data, 5).int_data, (long long)-1);
+            obs_test_eq(list_int_pop_back(list), 297);
+            obs_test_eq(list_int_length(list), 99);
+            list_int_clear(list);
+            obs_test_eq(list_int_length(list), 0);
+            list_int_free(list);
+        })
+
+        OBS_TEST("User defined types", {
+            List_u8 list = list_u8_new("bytes");
+            list_u8_push_back(list, 255);
+            obs_test_eq((int)sizeof(*list->data), (int)sizeof(unsigned char));
+            obs_test_eq(list_u8_read(list->data, 0).int_data, (long long)255);
+            list_u8_free(list);
+        })
+    })
+
+    OBS_TEST_GROUP("LLV_DEFINE_LL", {
+        OBS_TEST("Push, append and pop", {
+            LL_double list = ll_double_new("list");
+            ll_double_append(list, ll_double_new_node(1.5));
+            ll_double_append(list, ll_double_new_node(2.5));
+            ll_double_push(list, ll_double_new_node(0.5));
+            obs_test_eq(ll_double_length(list), 3);
+            obs_test_eq(list->head->value, 0.5);
+            obs_test_eq(list->tail->value, 2.5);
+
+            LL_Node_double node = ll_double_pop(list);
+            obs_test_eq(node->value, 0.5);
+            obs_test_null(node->next);
+            obs_test_eq(list->head->value, 1.5);
+            ll_double_free_node(node);
+
+            ll_double_clear(list);
+            obs_test_null(list->head);
+            obs_test_null(list->tail);
+            obs_test_null(ll_double_pop(list));
+            ll_double_free(list);
+        })
+
+        OBS_TEST("Nodes can be labelled", {
+            LL_Node_double node = ll_double_new_node(1);
+            SET_PTR(node, "cur");
+            obs_test_strcmp(node->ptr, "cur");
+            ll_double_free_node(node);
+        })
+
+        OBS_TEST("Printing finds the end without walking the middle", {
+            static char out[4096];
+            llv_set_headless(true);
+            LL_double list = ll_double_new("long");
+            for (int i = 0; i < 100000; i++) ll_double_append(list, ll_double_new_node(i));
+            LLVSink old = llv_set_sink(llv_memory_sink(out, sizeof(out), NULL));
+            update(1, list);
+
+            // the back node is a window from the tail and stays there
+            int wanted = list->back.wanted;
+            obs_test_eq(list->back.after, wanted);
+            obs_test_eq(((LL_Node_double)list->back.node)->value, (double)(99999 - wanted));
+            for (int i = 10; i > 0; i--) ll_double_append(list, ll_double_new_node(-i));
+            ll_double_free_node(ll_double_pop(list));
+            obs_test_eq(list->back.after, wanted);
+            LL_Node_double back = list->head;
+            for (int i = 0; i < list->len - 1 - wanted; i++) back = back->next;
+            obs_test_eq(list->back.node, (void*)back);
+
+            // so cutting the middle out doesn't change what is printed
+            LL_Node_double cut = list->head;
+            for (int i = 0; i < 50000; i++) cut = cut->next;
+            LL_Node_double after_cut = cut->next;
+            cut->next = NULL;
+            update(1, list);
+            LLVSink sink = llv_set_sink(old);
+            sink->close(sink);
+            obs_test_not_null(strstr(out, " -1 "));
+
+            cut->next = after_cut;
+            ll_double_free(list);
+            llv_set_headless(false);
+        })
+    })
+
+    OBS_REPORT;
+}
@@ -71,7 +71,7 @@ void reverse_standard(void) {
 }
 
 void bubble_sort(void) {
-    int values[] = ((int[]){1, 1000, 9, 90, 110, 54, 10});
+    int values[] = {1, 1000, 9, 90, 110, 54, 10};
 
     Array array = array_new("Sorting List", ARRAY_LEN(values));
     for (int i = 0; i < ARRAY_LEN(values); i++) {
@@ -160,8 +160,8 @@ void wiki_eg1(void) {
            LL_Node tmp = cur;
            cur = cur->next;
            ll_remove_node(list, tmp); // this also returns the removed node
-           // sidenote: you could write this out yourself
-           // by carrying around a prev ptr (or calling ll_find_prev)
+           // sidenote: this has to find the previous node, see wiki_eg3
+           // for an LL_Cursor which carries around a prev ptr for you
            // fmt_update is a fancy printf basically
            fmt_update("%l %s %n", list, "Removed Node:", tmp);
            ll_free_node(tmp); // if you care
@@ -209,8 +209,8 @@ void wiki_eg2(void) {
            LL_Node tmp = cur;
            cur = cur->next;
            ll_remove_node(list, tmp); // this also returns the removed node
-           // sidenote: you could write this out yourself
-           // by carrying around a prev ptr (or calling ll_find_prev)
+           // sidenote: this has to find the previous node, see wiki_eg3
+           // for an LL_Cursor which carries around a prev ptr for you
            // fmt_update is a fancy printf basically
            fmt_update("%l %s %n", list, "Removed Node:", tmp);
            ll_free_node(tmp); // if you care
@@ -247,23 +247,24 @@ void wiki_eg3(void) {
     // no need to have lists here we just want a lower and upper bound but why not
     fmt_update("%l %s %if %if", list, "Enter lower and then upper bound", &lower, &upper);
 
-    LL_Node cur = list->head;
-    attach_ptr(&cur, "cur");
+    // a cursor remembers the node before `cur` so removing is O(1)
+    // rather than ll_remove_node having to go looking for it
+    LL_Cursor cursor = ll_cursor(list);
+    attach_ptr(&cursor.cur, "cur");
     update(1, list);
-    while (cur != NULL) {
-       if (cur->data.flt_data < lower || cur->data.flt_data > upper) {
-           LL_Node tmp = cur;
-           cur = cur->next;
-           ll_remove_node(list, tmp);
+    while (cursor.cur != NULL) {
+       if (cursor.cur->data.flt_data < lower || cursor.cur->data.flt_data > upper) {
+           // also moves the cursor on to the next node
+           LL_Node tmp = ll_cursor_remove(&cursor);
            fmt_update("%l %s %n", list, "Removed Node:", tmp);
            ll_free_node(tmp);
        } else {
-           cur = cur->next;
+           ll_cursor_next(&cursor);
        }
     }
 
     fmt_update("%s %l", "Finished Removing Nodes out of bounds", list);
-    deattach_ptr(&cur, "cur");
+    deattach_ptr(&cursor.cur, "cur");
     ll_free(list);
 }
 
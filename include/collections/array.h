@@ -4,6 +4,7 @@
 #include <stdbool.h>
 #include "../types/shared_types.h"
 #include "../types/collection_skeleton.h"
+#include "../types/columns.h"
 
 typedef struct _array_t *Array;
 typedef struct _array_data_t *ArrayNode;
@@ -16,19 +17,40 @@ struct _array_data_t {
 
 struct _array_t {
    struct _collection_t parent;
-   ArrayNode data;
+   ArrayNode data;        // NULL for SoA arrays
+   DataColumns columns;   // NULL unless made by array_new_soa
    int len;
 };
 
 /* Create a new array with a given name and size */
 Array array_new(char *name, int size);
 
+/*
+   Create a new array that stores its elements as columns (see types/columns.h)
+   which costs 8 bytes an element (9 once they aren't all `tag`) rather than 24.
+   Elements start as 0 with the type `tag`.
+   array_at can't be used, use array_get and friends instead.
+*/
+Array array_new_soa(char *name, int size, TypeTag tag);
+
 /* Free the array */
 void array_free(Array array);
 
-/* Get the array node at the given index */
+/* Get the array node at the given index (not for SoA arrays) */
 ArrayNode array_at(Array array, int index);
 
+/* The data at the given index */
+Data array_get(Array array, int index);
+
+/* The type of the data at the given index */
+TypeTag array_get_tag(Array array, int index);
+
+/* The label at the given index or NULL if it has none */
+char *array_get_ptr(Array array, int index);
+
+/* Labels the given index (NULL removes the label) */
+void array_set_ptr(Array array, int index, char *ptr);
+
 /*
    Create a new array node for use in the other functions 
    Could use NEW_NODE(array, data) instead! 
@@ -45,6 +67,16 @@ void array_resize(Array array, int new_size);
 */
 void array_set(Array array, int index, struct _array_data_t node);
 
+/*
+   A new array holding the `n` items in order.
+*/
+Array array_from_array(char *name, DataArray items, int n);
+
+/*
+   Grows the array by `n` and puts the items in the new slots in order.
+*/
+void array_append_n(Array array, DataArray items, int n);
+
 /*
    Get the array length.
 */
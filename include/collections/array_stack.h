@@ -0,0 +1,77 @@
+#ifndef LLV_ARRAY_STACK_H
+#define LLV_ARRAY_STACK_H
+
+#include <stdbool.h>
+
+#include "../types/shared_types.h"
+#include "../types/collection_skeleton.h"
+
+/*
+    A stack kept in one growable buffer rather than a node per item,
+    so push/pop don't allocate (bar the odd doubling) and items are copied
+    in and out by value.  It prints bottom first like an Array with the
+    index of the top.
+*/
+
+typedef struct _array_stack_t *ArrayStack;
+typedef struct _array_stack_data_t *ArrayStackNode;
+
+struct _array_stack_data_t {
+    char *ptr;
+    Data data; // the data type
+    TypeTag data_tag; // the corresponding tag;
+};
+
+struct _array_stack_t {
+    struct _collection_t parent;
+    ArrayStackNode data;
+    int len;
+    int capacity;
+};
+
+/* Create a new array stack with a given name */
+ArrayStack array_stack_new(char *name);
+
+/* Frees the stack and its buffer */
+void array_stack_free(ArrayStack stack);
+
+/* Returns how many items are currently on the stack */
+int array_stack_length(ArrayStack stack);
+
+/* Returns true if there are no items on the stack */
+bool array_stack_is_empty(ArrayStack stack);
+
+/* Empties the stack but keeps its buffer */
+void array_stack_clear(ArrayStack stack);
+
+/* Makes sure the stack can hold `len` items without growing */
+void array_stack_reserve(ArrayStack stack, int len);
+
+/*
+   Create a new node
+   Could use NEW_NODE(array_stack, data)
+*/
+struct _array_stack_data_t array_stack_new_node(Data data, TypeTag type);
+
+/* Pushes a copy of node onto the top of the stack */
+void array_stack_push(ArrayStack stack, struct _array_stack_data_t node);
+
+/* Create a new stack as if the `n` items were pushed in order */
+ArrayStack array_stack_from_array(char *name, DataArray items, int n);
+
+/* Pushes the `n` items in order (the last ends up on top), growing at most once */
+void array_stack_push_n(ArrayStack stack, DataArray items, int n);
+
+/* Pops the item from the top of the stack, it must not be empty */
+struct _array_stack_data_t array_stack_pop(ArrayStack stack);
+
+/*
+    The item `index` from the bottom (0 is the bottom) or NULL if there isn't one,
+    only valid until the stack next changes.
+*/
+ArrayStackNode array_stack_at(ArrayStack stack, int index);
+
+/* The item on top or NULL if the stack is empty */
+ArrayStackNode array_stack_top(ArrayStack stack);
+
+#endif /* LLV_ARRAY_STACK_H */
@@ -18,6 +18,8 @@ typedef struct _doubly_linked_list_t {
     struct _collection_t parent;   // all the inherited members
     DLL_Node head;      // the head of the list
     DLL_Node tail;      // the tail of the list
+    int len;            // how many nodes are in the list
+    DLL_Node *focus;    // if set we print the nodes around *focus
 } *DLL;
 
 /*
@@ -100,4 +102,53 @@ DLL_Node dll_pop(DLL list);
 */
 void dll_append(DLL list, DLL_Node n);
 
+/*
+    A new list holding the `n` items in order.
+*/
+DLL dll_from_array(char *name, DataArray items, int n);
+
+/*
+    Adds the `n` items to the end of the list in order,
+    their nodes are allocated together in one go.
+*/
+void dll_append_n(DLL list, DataArray items, int n);
+
+/*
+    Sorts the list in place (stable, O(n log n) and allocation free) using
+    `cmp` or data_compare if it is NULL.
+*/
+void dll_sort(DLL list, fn_data_compare cmp);
+
+/*
+    Same as dll_sort but shows the list (`update(1, list)`) after every
+    `passes_per_frame` merge passes and once it is sorted.
+*/
+void dll_sort_animated(DLL list, fn_data_compare cmp, int passes_per_frame);
+
+/*
+    Moves all of `other`'s nodes onto the end of `list`, leaving `other` empty.
+*/
+void dll_concat(DLL list, DLL other);
+
+/*
+    Moves all of `other`'s nodes in after `at` (or at the front if `at` is
+    NULL), leaving `other` empty.
+*/
+void dll_splice(DLL list, DLL_Node at, DLL other);
+
+/*
+    Moves the nodes from `index` onwards into a new list called `name`,
+    only walks the first `index` nodes.
+*/
+DLL dll_split_at(DLL list, int index, char *name);
+
+/*
+    Prints the nodes around whichever node `*focus` is (i.e. the same variable
+    you would give attach_ptr) rather than the head and tail.
+    NULL (or `*focus` being NULL) goes back to normal, `*focus` must be in the list.
+    Removing the node `*focus` is (or clearing/splitting it off) sets the focus
+    back to NULL, only the nodes around it are looked at when printing.
+*/
+void dll_set_focus(DLL list, DLL_Node *focus);
+
 #endif /* LLV_DOUBLY_LINKED_LIST_H */
@@ -0,0 +1,122 @@
+#ifndef LLV_INTRUSIVE_H
+#define LLV_INTRUSIVE_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "../types/shared_types.h"
+#include "../types/collection_skeleton.h"
+#include "../llv.h"
+
+/*
+    Shows a linked list made of your own structs without copying it into
+    LL_Nodes, i.e. for
+
+        struct job { int id; struct job *next; struct job *prev; };
+        struct job *jobs = ...;
+
+    you describe where things are in a `struct job`
+
+        IntrusiveList list = intrusive_new("jobs", &jobs,
+                                           LLV_INTRUSIVE_DLL(struct job, next, prev, id));
+
+    and `update(1, list)` draws whatever `jobs` points to at the time
+    (with the DLL printer if there is a prev, otherwise the LL one).
+    Only the nodes at either end that could fit on screen are read so a
+    list of any length costs at most one walk of its next pointers a frame,
+    or none if it is doubly linked and you give it a tail (intrusive_set_tail).
+    The list must be NULL terminated.
+*/
+
+// for a part of the node that doesn't exist
+#define LLV_NO_OFFSET ((size_t)-1)
+
+/*
+    Where everything is in one of your nodes.
+*/
+typedef struct _intrusive_desc_t {
+    size_t next_offset;
+    size_t prev_offset;         // LLV_NO_OFFSET if singly linked
+    size_t value_offset;
+    DataArrayKind value_kind;   // what the value is, i.e. DATA_ARRAY_INT for an `int`
+    TypeTag value_tag;
+    size_t label_offset;        // a `char *` shown under the node, or LLV_NO_OFFSET
+    fn_typed_read value_read;   // if set reads the value rather than `value_kind`
+} IntrusiveDesc;
+
+#ifdef MODERN_C
+    // the kind and tag are worked out from the type of `value`
+#   define LLV_INTRUSIVE_DLL(type, next, prev, value)                  \
+        ((IntrusiveDesc){                                               \
+            .next_offset = offsetof(type, next),                        \
+            .prev_offset = offsetof(type, prev),                        \
+            .value_offset = offsetof(type, value),                      \
+            .value_kind = DATA_ARRAY_KIND(&((type*)0)->value),          \
+            .value_tag = DATA_ARRAY_TAG(&((type*)0)->value),            \
+            .label_offset = LLV_NO_OFFSET,                              \
+            .value_read = NULL,                                         \
+        })
+
+#   define LLV_INTRUSIVE_LL(type, next, value)                         \
+        ((IntrusiveDesc){                                               \
+            .next_offset = offsetof(type, next),                        \
+            .prev_offset = LLV_NO_OFFSET,                               \
+            .value_offset = offsetof(type, value),                      \
+            .value_kind = DATA_ARRAY_KIND(&((type*)0)->value),          \
+            .value_tag = DATA_ARRAY_TAG(&((type*)0)->value),            \
+            .label_offset = LLV_NO_OFFSET,                              \
+            .value_read = NULL,                                         \
+        })
+#endif
+
+typedef struct _intrusive_list_t {
+    struct _collection_t parent;
+    IntrusiveDesc desc;
+    void *head;     // the address of your head pointer, read every frame
+    void *tail;     // the address of your tail pointer or NULL if you don't have one
+} *IntrusiveList;
+
+/*
+    Create a new intrusive list, `head` is the address of the variable
+    (or member) that points to your first node.
+*/
+IntrusiveList intrusive_new(char *name, void *head, IntrusiveDesc desc);
+
+/*
+    Frees the list, your nodes are left alone.
+*/
+void intrusive_free(IntrusiveList list);
+
+/*
+    `tail` is the address of your pointer to the last node (NULL for none),
+    for doubly linked lists this saves walking to the end every frame.
+*/
+void intrusive_set_tail(IntrusiveList list, void *tail);
+
+/*
+    How many nodes there are right now (this walks the list).
+*/
+int intrusive_length(IntrusiveList list);
+
+/*
+    Prints the nodes from `head` (and `tail` if it is non NULL and the list
+    is doubly linked) as described by `desc`, for collections of your own.
+*/
+void intrusive_print_nodes(Collection c, const void *head, const void *tail,
+                           const IntrusiveDesc *desc);
+
+/*
+    Same as intrusive_print_nodes for a singly linked list where you know a
+    node `back` that is `back_index` nodes from `head` and at least
+    intrusive_window(false) nodes from the end (or NULL if you don't),
+    the end of the list is then found by walking from it rather than `head`.
+*/
+void intrusive_print_from(Collection c, const void *head, const void *back, int back_index,
+                          const IntrusiveDesc *desc);
+
+/*
+    The most nodes that could be shown from either end of a list right now.
+*/
+int intrusive_window(bool doubly);
+
+#endif /* LLV_INTRUSIVE_H */
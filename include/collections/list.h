@@ -3,6 +3,7 @@
 
 #include "../types/shared_types.h"
 #include "../types/collection_skeleton.h"
+#include "../types/columns.h"
 
 typedef struct _list_t *List;
 typedef struct _list_data_t *ListNode;
@@ -17,7 +18,8 @@ struct _list_data_t {
 
 struct _list_t {
     struct _collection_t parent;
-    ListNode data;
+    ListNode data;          // NULL for SoA lists
+    DataColumns columns;    // NULL unless made by list_new_soa
     int cur_len;
     int max_len;
     fn_growth_factor grow_function;
@@ -30,6 +32,13 @@ struct _list_t {
 */
 List list_new(char *name);
 
+/*
+    Create a new list that stores its elements as columns (see types/columns.h)
+    which costs 8 bytes an element (9 once they aren't all `tag`) rather than 24.
+    list_at can't be used, use list_get and friends instead.
+*/
+List list_new_soa(char *name, TypeTag tag);
+
 /*
     Frees the list.
 */
@@ -60,10 +69,30 @@ int poly_grow_function(int old_len, int min_new_len, double factor);
 int exponential_grow_function(int old_len, int min_new_len, double factor);
 
 /*
-    Get the node at the index given.
+    Get the node at the index given (not for SoA lists).
 */
 ListNode list_at(List list, int index);
 
+/*
+    The data at the index given.
+*/
+Data list_get(List list, int index);
+
+/*
+    The type of the data at the index given.
+*/
+TypeTag list_get_tag(List list, int index);
+
+/*
+    The label at the index given or NULL if it has none.
+*/
+char *list_get_ptr(List list, int index);
+
+/*
+    Labels the index given (NULL removes the label).
+*/
+void list_set_ptr(List list, int index, char *ptr);
+
 /*
     Creates a new list node.
     Used for the other functions
@@ -85,6 +114,17 @@ void list_clear(List list, int release_memory);
 */
 void list_push_back(List list, struct _list_data_t node);
 
+/*
+    A new list holding the `n` items in order, its capacity is exactly `n`.
+*/
+List list_from_array(char *name, DataArray items, int n);
+
+/*
+    Pushes the `n` items to the back of the list in order,
+    growing at most once.
+*/
+void list_append_n(List list, DataArray items, int n);
+
 /*
     Inserts node after index given.
 */
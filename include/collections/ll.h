@@ -8,6 +8,18 @@
 
 typedef struct _LL_node_t *LL_Node;
 
+/*
+    Walks a list remembering the node before the current one, so removing
+    the current node or inserting before it is constant time
+    (ll_remove_node and ll_insert_before have to search for it).
+    You can attach_ptr(&cursor.cur, ...) like any other node variable.
+*/
+typedef struct _ll_cursor_t {
+    LL list;
+    LL_Node prev;   // NULL if cur is the head
+    LL_Node cur;    // NULL once we've gone past the tail
+} LL_Cursor;
+
 /*
     Create a new list with a given name and a default type.
 */
@@ -88,4 +100,85 @@ LL_Node ll_pop(LL list);
 */
 void ll_append(LL list, LL_Node n);
 
+/*
+    A new list holding the `n` items in order.
+*/
+LL ll_from_array(char *name, DataArray items, int n);
+
+/*
+    Adds the `n` items to the end of the list in order,
+    their nodes are allocated together in one go.
+*/
+void ll_append_n(LL list, DataArray items, int n);
+
+/*
+    Same as pushing each of the `n` items in order (so the last is the head),
+    their nodes are allocated together in one go.
+*/
+void ll_push_n(LL list, DataArray items, int n);
+
+/*
+    Removes the node after `at` (or the head if `at` is NULL),
+    returning it or NULL if there is nothing after `at`.
+*/
+LL_Node ll_remove_after(LL list, LL_Node at);
+
+/*
+    A cursor at the head of the list.
+*/
+LL_Cursor ll_cursor(LL list);
+
+/*
+    Moves the cursor to the next node, does nothing once past the tail.
+*/
+void ll_cursor_next(LL_Cursor *cursor);
+
+/*
+    Removes the node the cursor is at, returning it (or NULL if the cursor is
+    past the tail).  The cursor moves on to the node after it.
+*/
+LL_Node ll_cursor_remove(LL_Cursor *cursor);
+
+/*
+    Inserts the given node before the one the cursor is at (or at the end if
+    the cursor is past the tail).  The cursor stays at the same node.
+*/
+void ll_cursor_insert_before(LL_Cursor *cursor, LL_Node node);
+
+/*
+    Sorts the list in place (stable, O(n log n) and allocation free) using
+    `cmp` or data_compare if it is NULL.
+*/
+void ll_sort(LL list, fn_data_compare cmp);
+
+/*
+    Same as ll_sort but shows the list (`update(1, list)`) after every
+    `passes_per_frame` merge passes and once it is sorted.
+*/
+void ll_sort_animated(LL list, fn_data_compare cmp, int passes_per_frame);
+
+/*
+    Moves all of `other`'s nodes onto the end of `list`, leaving `other` empty.
+*/
+void ll_concat(LL list, LL other);
+
+/*
+    Moves all of `other`'s nodes in after `at` (or at the front if `at` is
+    NULL), leaving `other` empty.
+*/
+void ll_splice(LL list, LL_Node at, LL other);
+
+/*
+    Moves the nodes from `index` onwards into a new list called `name`,
+    only walks the first `index` nodes.
+*/
+LL ll_split_at(LL list, int index, char *name);
+
+/*
+    Prints the nodes around whichever node `*focus` is (i.e. the same variable
+    you would give attach_ptr) rather than the head and tail.
+    NULL (or `*focus` being NULL or not in the list) goes back to normal.
+*/
+void ll_set_focus(LL list, LL_Node *focus);
+
 #endif /* LLV_LINKED_LIST_H */
@@ -19,6 +19,9 @@ typedef struct _singly_linked_list_t {
     struct _collection_t parent;   // inherited members
     struct _LL_node_t *head;       // the front of the list
     struct _LL_node_t *tail;       // the back of the list
+    int len;                       // how many nodes are in the list
+    struct _LL_node_t **focus;     // if set we print the nodes around *focus
+    struct _LL_node_t *anchor;     // where we start looking for the focus from
 } *LL;
 
 #endif /* LLV_LINKED_LIST_STRUCTS_H */
@@ -37,6 +37,12 @@ QueueNode queue_new_node(Data data, TypeTag type);
 */
 void queue_enqueue(Queue queue, QueueNode node);
 
+/* Create a new queue holding the `n` items, the first at the front */
+Queue queue_from_array(char *name, DataArray items, int n);
+
+/* Adds the `n` items to the end of the queue in order */
+void queue_enqueue_n(Queue queue, DataArray items, int n);
+
 /*
     Takes an object from the front of the queue.
 */
@@ -0,0 +1,78 @@
+#ifndef LLV_RING_QUEUE_H
+#define LLV_RING_QUEUE_H
+
+#include <stdbool.h>
+
+#include "../types/shared_types.h"
+#include "../types/collection_skeleton.h"
+
+/*
+    A queue kept in one growable circular buffer rather than a node per item,
+    so enqueue/dequeue don't allocate (bar the odd doubling) and items are
+    copied in and out by value.  It prints front first like an Array with
+    where `head` (the front) and `tail` (the next free slot) are in the buffer.
+*/
+
+typedef struct _ring_queue_t *RingQueue;
+typedef struct _ring_queue_data_t *RingQueueNode;
+
+struct _ring_queue_data_t {
+    char *ptr;
+    Data data; // the data type
+    TypeTag data_tag; // the corresponding tag;
+};
+
+struct _ring_queue_t {
+    struct _collection_t parent;
+    RingQueueNode data;
+    int head;       // index of the front
+    int len;
+    int capacity;   // always 0 or a power of 2
+};
+
+/* Create a new ring queue with a given name */
+RingQueue ring_queue_new(char *name);
+
+/* Frees the ring queue and its buffer */
+void ring_queue_free(RingQueue queue);
+
+/* Returns how many items are currently in the queue */
+int ring_queue_length(RingQueue queue);
+
+/* Returns true if there are no items in the queue */
+bool ring_queue_is_empty(RingQueue queue);
+
+/* Empties the queue but keeps its buffer */
+void ring_queue_clear(RingQueue queue);
+
+/* Makes sure the queue can hold `len` items without growing */
+void ring_queue_reserve(RingQueue queue, int len);
+
+/*
+   Create a new node
+   Could use NEW_NODE(ring_queue, data)
+*/
+struct _ring_queue_data_t ring_queue_new_node(Data data, TypeTag type);
+
+/* Adds a copy of node to the end of the queue */
+void ring_queue_enqueue(RingQueue queue, struct _ring_queue_data_t node);
+
+/* Create a new ring queue holding the `n` items, the first at the front */
+RingQueue ring_queue_from_array(char *name, DataArray items, int n);
+
+/* Adds the `n` items to the end of the queue in order, growing at most once */
+void ring_queue_enqueue_n(RingQueue queue, DataArray items, int n);
+
+/* Takes the item from the front of the queue, it must not be empty */
+struct _ring_queue_data_t ring_queue_dequeue(RingQueue queue);
+
+/*
+    The item `index` from the front (0 is the front) or NULL if there isn't one,
+    only valid until the queue next changes.
+*/
+RingQueueNode ring_queue_at(RingQueue queue, int index);
+
+/* Same as ring_queue_at(queue, 0) */
+RingQueueNode ring_queue_front(RingQueue queue);
+
+#endif /* LLV_RING_QUEUE_H */
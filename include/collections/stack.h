@@ -35,6 +35,12 @@ StackNode stack_new_node(Data data, TypeTag type);
 /* Pushes a new node onto the top of the stack */
 void stack_push(Stack stack, StackNode node);
 
+/* Create a new stack as if the `n` items were pushed in order */
+Stack stack_from_array(char *name, DataArray items, int n);
+
+/* Pushes the `n` items in order, the last ends up on top */
+void stack_push_n(Stack stack, DataArray items, int n);
+
 /* Pops a node form the top of the stack */
 StackNode stack_pop(Stack stack);
 
@@ -0,0 +1,347 @@
+#ifndef LLV_TYPED_H
+#define LLV_TYPED_H
+
+#include <string.h>
+#include <stddef.h>
+
+#include "../types/shared_types.h"
+#include "../types/collection_skeleton.h"
+#include "../types/allocator.h"
+#include "../helper.h"
+
+/*
+    Collections specialised for one element type, i.e.
+
+        LLV_DEFINE_LIST(int)
+        LLV_DEFINE_LL(double)
+        LLV_DEFINE_ARRAY(str)
+
+    at file scope gives you `List_int`, `LL_double` and `Array_str` (and their
+    `list_int_*`, `ll_double_*` and `array_str_*` functions).  They store the
+    values themselves (an `int` is 4 bytes, not a 24 byte node) with no TypeTag
+    since every element has the same one, and reading an element to print it is
+    a function made for that type.  They are still collections so you can
+    `update(1, list)` them like any other.
+
+    Out of the box the types are int, long, float, double, str (char *) and
+    ptr (void *), add your own by defining the same three macros
+    (LLV_TYPED_<name>_TYPE, _TAG and _DATA(value)) before using LLV_DEFINE_*.
+
+    Typed Arrays and Lists have no per element ptr labels,
+    typed LL nodes do (use SET_PTR as normal).
+*/
+
+#define LLV_TYPED_int_TYPE int
+#define LLV_TYPED_int_TAG INTEGER
+#define LLV_TYPED_int_DATA(value) data_int(value)
+
+#define LLV_TYPED_long_TYPE long
+#define LLV_TYPED_long_TAG INTEGER
+#define LLV_TYPED_long_DATA(value) data_int(value)
+
+#define LLV_TYPED_float_TYPE float
+#define LLV_TYPED_float_TAG FLOAT
+#define LLV_TYPED_float_DATA(value) data_flt(value)
+
+#define LLV_TYPED_double_TYPE double
+#define LLV_TYPED_double_TAG FLOAT
+#define LLV_TYPED_double_DATA(value) data_flt(value)
+
+#define LLV_TYPED_str_TYPE char *
+#define LLV_TYPED_str_TAG STRING
+#define LLV_TYPED_str_DATA(value) data_str(value)
+
+#define LLV_TYPED_ptr_TYPE void *
+#define LLV_TYPED_ptr_TAG ANY
+#define LLV_TYPED_ptr_DATA(value) data_any(value)
+
+/*
+    Prints `len` elements of `items` read through `read` (all `tag`)
+    the same way an Array/List is printed.
+*/
+void llv_typed_print_array(Collection c, char *collection_type, const void *items, int len,
+                           fn_typed_read read, TypeTag tag);
+
+/*
+    A node near the end of a typed LL so printing doesn't have to walk the
+    whole list to find its last nodes, append and pop keep it in place.
+*/
+typedef struct _llv_typed_back_t {
+    void *node;     // `after` nodes before the tail, NULL if we don't have one
+    int after;
+    int wanted;     // how many nodes the printer last wanted after it
+} LLVTypedBack;
+
+/*
+    Moves `back` along after a node is appended so it doesn't fall behind.
+*/
+void llv_typed_back_append(LLVTypedBack *back, size_t next_offset);
+
+/*
+    Prints the `len` linked nodes from `head` the same way an LL is printed
+    (see collections/intrusive.h).  Each node's value is read through
+    `read(node, 0)`, so it must be the first member, its ptr label is the
+    `char *` at `ptr_offset` and the next node is the pointer at `next_offset`.
+    Only the nodes at either end are walked, `back` says where the end is.
+*/
+void llv_typed_print_ll(Collection c, const void *head, int len, LLVTypedBack *back,
+                        size_t ptr_offset, size_t next_offset, fn_typed_read read, TypeTag tag);
+
+/*
+    Sets up the collection parts of a typed collection.
+*/
+void llv_typed_init(Collection c, char *name, fn_print_list printer, LLVAllocator allocator);
+
+/* Array */
+
+#define LLV_DEFINE_ARRAY(name)                                                              \
+    typedef struct _array_##name##_t {                                                      \
+        struct _collection_t parent;                                                        \
+        LLV_TYPED_##name##_TYPE *data;                                                      \
+        int len;                                                                            \
+    } *Array_##name;                                                                        \
+                                                                                            \
+    static inline Data array_##name##_read(const void *items, int index) {                  \
+        return LLV_TYPED_##name##_DATA(((LLV_TYPED_##name##_TYPE*)items)[index]);           \
+    }                                                                                       \
+                                                                                            \
+    static inline void array_##name##_print(Collection c) {                                 \
+        Array_##name array = (Array_##name)c;                                               \
+        llv_typed_print_array(c, "Array", array->data, array->len,                          \
+                              array_##name##_read, LLV_TYPED_##name##_TAG);                 \
+    }                                                                                       \
+                                                                                            \
+    /* A new array of `size` zeroed elements */                                             \
+    static inline Array_##name array_##name##_new(char *name_, int size) {                  \
+        LLVAllocator allocator = llv_allocator();                                           \
+        Array_##name array = (Array_##name)llv_alloc(allocator,                             \
+                                                     sizeof(struct _array_##name##_t),      \
+                                                     "Array_" #name);                       \
+        llv_typed_init(&array->parent, name_, array_##name##_print, allocator);             \
+        array->len = size;                                                                  \
+        array->data = NULL;                                                                 \
+        if (size > 0) {                                                                     \
+            size_t bytes = sizeof(LLV_TYPED_##name##_TYPE) * size;                          \
+            array->data = (LLV_TYPED_##name##_TYPE*)llv_alloc(allocator, bytes,             \
+                                                              "Array_" #name " Data");      \
+            memset(array->data, 0, bytes);                                                  \
+        }                                                                                   \
+        return array;                                                                       \
+    }                                                                                       \
+                                                                                            \
+    static inline void array_##name##_free(Array_##name array) {                            \
+        llv_free(array->parent.allocator, array->data,                                      \
+                 sizeof(LLV_TYPED_##name##_TYPE) * array->len);                             \
+        llv_free(array->parent.allocator, array, sizeof(struct _array_##name##_t));         \
+    }                                                                                       \
+                                                                                            \
+    static inline LLV_TYPED_##name##_TYPE *array_##name##_at(Array_##name array,            \
+                                                             int index) {                   \
+        assert_msg(index >= 0 && index < array->len, "typed:array_" #name "_at, "           \
+                   "index (%d) must be in [0, %d)\n", index, array->len);                   \
+        return &array->data[index];                                                         \
+    }                                                                                       \
+                                                                                            \
+    /* Resizes the array, new elements are zeroed */                                        \
+    static inline void array_##name##_resize(Array_##name array, int new_size) {            \
+        size_t elem = sizeof(LLV_TYPED_##name##_TYPE);                                      \
+        array->data = (LLV_TYPED_##name##_TYPE*)llv_realloc(array->parent.allocator,        \
+                                                            array->data,                    \
+                                                            elem * array->len,              \
+                                                            elem * new_size,                \
+                                                            "Array_" #name " Data");        \
+        if (new_size > array->len) {                                                        \
+            memset(array->data + array->len, 0, elem * (new_size - array->len));           \
+        }                                                                                   \
+        array->len = new_size;                                                              \
+    }                                                                                       \
+                                                                                            \
+    static inline int array_##name##_length(Array_##name array) {                           \
+        return array->len;                                                                  \
+    }
+
+/* List */
+
+#define LLV_DEFINE_LIST(name)                                                               \
+    typedef struct _list_##name##_t {                                                       \
+        struct _collection_t parent;                                                        \
+        LLV_TYPED_##name##_TYPE *data;                                                      \
+        int cur_len;                                                                        \
+        int max_len;                                                                        \
+    } *List_##name;                                                                         \
+                                                                                            \
+    static inline Data list_##name##_read(const void *items, int index) {                   \
+        return LLV_TYPED_##name##_DATA(((LLV_TYPED_##name##_TYPE*)items)[index]);           \
+    }                                                                                       \
+                                                                                            \
+    static inline void list_##name##_print(Collection c) {                                  \
+        List_##name list = (List_##name)c;                                                  \
+        llv_typed_print_array(c, "List", list->data, list->cur_len,                         \
+                              list_##name##_read, LLV_TYPED_##name##_TAG);                  \
+    }                                                                                       \
+                                                                                            \
+    static inline List_##name list_##name##_new(char *name_) {                              \
+        LLVAllocator allocator = llv_allocator();                                           \
+        List_##name list = (List_##name)llv_alloc(allocator,                                \
+                                                  sizeof(struct _list_##name##_t),          \
+                                                  "List_" #name);                           \
+        llv_typed_init(&list->parent, name_, list_##name##_print, allocator);               \
+        list->data = NULL;                                                                  \
+        list->cur_len = list->max_len = 0;                                                  \
+        return list;                                                                        \
+    }                                                                                       \
+                                                                                            \
+    static inline void list_##name##_free(List_##name list) {                               \
+        llv_free(list->parent.allocator, list->data,                                        \
+                 sizeof(LLV_TYPED_##name##_TYPE) * list->max_len);                          \
+        llv_free(list->parent.allocator, list, sizeof(struct _list_##name##_t));            \
+    }                                                                                       \
+                                                                                            \
+    /* Makes room for at least `len` elements without growing again */                      \
+    static inline void list_##name##_reserve(List_##name list, int len) {                   \
+        if (len <= list->max_len) return;                                                   \
+        size_t elem = sizeof(LLV_TYPED_##name##_TYPE);                                      \
+        list->data = (LLV_TYPED_##name##_TYPE*)llv_realloc(list->parent.allocator,          \
+                                                           list->data,                      \
+                                                           elem * list->max_len,            \
+                                                           elem * len,                      \
+                                                           "List_" #name " Data");          \
+        list->max_len = len;                                                                \
+    }                                                                                       \
+                                                                                            \
+    static inline void list_##name##_push_back(List_##name list,                            \
+                                               LLV_TYPED_##name##_TYPE value) {             \
+        if (list->cur_len == list->max_len) {                                               \
+            list_##name##_reserve(list, list->max_len < 4 ? 4 : list->max_len * 2);         \
+        }                                                                                   \
+        list->data[list->cur_len++] = value;                                                \
+    }                                                                                       \
+                                                                                            \
+    static inline LLV_TYPED_##name##_TYPE list_##name##_pop_back(List_##name list) {        \
+        assert_msg(list->cur_len > 0, "typed:list_" #name "_pop_back, list is empty\n");    \
+        return list->data[--list->cur_len];                                                 \
+    }                                                                                       \
+                                                                                            \
+    static inline LLV_TYPED_##name##_TYPE *list_##name##_at(List_##name list, int index) {  \
+        assert_msg(index >= 0 && index < list->cur_len, "typed:list_" #name "_at, "         \
+                   "index (%d) must be in [0, %d)\n", index, list->cur_len);                \
+        return &list->data[index];                                                          \
+    }                                                                                       \
+                                                                                            \
+    static inline int list_##name##_length(List_##name list) {                              \
+        return list->cur_len;                                                               \
+    }                                                                                       \
+                                                                                            \
+    /* Empties the list but keeps its memory */                                             \
+    static inline void list_##name##_clear(List_##name list) {                              \
+        list->cur_len = 0;                                                                  \
+    }
+
+/* LL */
+
+/*
+    Nodes come from the allocator that is current when they are made
+    so free them while it still is.
+*/
+#define LLV_DEFINE_LL(name)                                                                 \
+    typedef struct _ll_##name##_node_t {                                                    \
+        LLV_TYPED_##name##_TYPE value;  /* has to be first, see llv_typed_print_ll */       \
+        char *ptr;                                                                          \
+        struct _ll_##name##_node_t *next;                                                   \
+    } *LL_Node_##name;                                                                      \
+                                                                                            \
+    typedef struct _ll_##name##_t {                                                         \
+        struct _collection_t parent;                                                        \
+        LL_Node_##name head;                                                                \
+        LL_Node_##name tail;                                                                \
+        int len;                                                                            \
+        LLVTypedBack back;                                                                  \
+    } *LL_##name;                                                                           \
+                                                                                            \
+    static inline Data ll_##name##_read(const void *items, int index) {                     \
+        return LLV_TYPED_##name##_DATA(((LLV_TYPED_##name##_TYPE*)items)[index]);           \
+    }                                                                                       \
+                                                                                            \
+    static inline void ll_##name##_print(Collection c) {                                    \
+        LL_##name list = (LL_##name)c;                                                      \
+        llv_typed_print_ll(c, list->head, list->len, &list->back,                           \
+                           offsetof(struct _ll_##name##_node_t, ptr),                       \
+                           offsetof(struct _ll_##name##_node_t, next),                      \
+                           ll_##name##_read, LLV_TYPED_##name##_TAG);                       \
+    }                                                                                       \
+                                                                                            \
+    static inline LL_##name ll_##name##_new(char *name_) {                                  \
+        LLVAllocator allocator = llv_allocator();                                           \
+        LL_##name list = (LL_##name)llv_alloc(allocator, sizeof(struct _ll_##name##_t),     \
+                                              "LL_" #name);                                 \
+        llv_typed_init(&list->parent, name_, ll_##name##_print, allocator);                 \
+        list->head = list->tail = NULL;                                                     \
+        list->len = 0;                                                                      \
+        list->back = (LLVTypedBack){ NULL, 0, 0 };                                          \
+        return list;                                                                        \
+    }                                                                                       \
+                                                                                            \
+    static inline LL_Node_##name ll_##name##_new_node(LLV_TYPED_##name##_TYPE value) {      \
+        LL_Node_##name node = (LL_Node_##name)llv_alloc(NULL,                               \
+                                                        sizeof(struct _ll_##name##_node_t), \
+                                                        "LL_Node_" #name);                  \
+        node->value = value;                                                                \
+        node->ptr = NULL;                                                                   \
+        node->next = NULL;                                                                  \
+        return node;                                                                        \
+    }                                                                                       \
+                                                                                            \
+    static inline void ll_##name##_free_node(LL_Node_##name node) {                         \
+        llv_free(NULL, node, sizeof(struct _ll_##name##_node_t));                           \
+    }                                                                                       \
+                                                                                            \
+    /* Frees all the nodes in the list */                                                   \
+    static inline void ll_##name##_clear(LL_##name list) {                                  \
+        for (LL_Node_##name cur = list->head; cur != NULL;) {                               \
+            LL_Node_##name next = cur->next;                                                \
+            ll_##name##_free_node(cur);                                                     \
+            cur = next;                                                                     \
+        }                                                                                   \
+        list->head = list->tail = NULL;                                                     \
+        list->len = 0;                                                                      \
+        list->back.node = NULL;                                                             \
+    }                                                                                       \
+                                                                                            \
+    static inline void ll_##name##_free(LL_##name list) {                                   \
+        ll_##name##_clear(list);                                                            \
+        llv_free(list->parent.allocator, list, sizeof(struct _ll_##name##_t));              \
+    }                                                                                       \
+                                                                                            \
+    static inline void ll_##name##_push(LL_##name list, LL_Node_##name node) {              \
+        node->next = list->head;                                                            \
+        if (list->head == NULL) list->tail = node;                                          \
+        list->head = node;                                                                  \
+        list->len++;                                                                        \
+    }                                                                                       \
+                                                                                            \
+    static inline void ll_##name##_append(LL_##name list, LL_Node_##name node) {            \
+        node->next = NULL;                                                                  \
+        if (list->tail == NULL) list->head = node;                                          \
+        else list->tail->next = node;                                                       \
+        list->tail = node;                                                                  \
+        list->len++;                                                                        \
+        llv_typed_back_append(&list->back, offsetof(struct _ll_##name##_node_t, next));     \
+    }                                                                                       \
+                                                                                            \
+    /* Removes the node at the front, NULL if the list is empty */                          \
+    static inline LL_Node_##name ll_##name##_pop(LL_##name list) {                          \
+        LL_Node_##name node = list->head;                                                   \
+        if (node == NULL) return NULL;                                                      \
+        list->head = node->next;                                                            \
+        if (list->head == NULL) list->tail = NULL;                                          \
+        if (list->back.node == node) list->back.node = NULL;                                \
+        node->next = NULL;                                                                  \
+        list->len--;                                                                        \
+        return node;                                                                        \
+    }                                                                                       \
+                                                                                            \
+    static inline int ll_##name##_length(LL_##name list) {                                  \
+        return list->len;                                                                   \
+    }
+
+#endif /* LLV_TYPED_H */
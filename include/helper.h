@@ -8,12 +8,15 @@
 
 #ifdef _WIN32
 #   define WINDOWS_COMPATIBILITY
-#   define CLEAR_SCREEN "cls"
 #else
 #   define UNIX_COMPATIBILITY
-#   define CLEAR_SCREEN "clear"
 #endif
 
+// home the cursor, clear the screen then clear the scrollback (same as `clear`)
+#define CLEAR_SCREEN "\x1b[H\x1b[2J\x1b[3J"
+#define ALTERNATE_SCREEN_ENTER "\x1b[?1049h"
+#define ALTERNATE_SCREEN_LEAVE "\x1b[?1049l"
+
 typedef struct _terminal_int {
     int width;
     int height;
@@ -34,6 +37,23 @@ void write_str_repeat_char_grid(wchar_t **buf, int offset, wchar_t c, int vert_c
 
 terminalSize get_terminal_size(void);
 
+/*
+    Makes sure the terminal understands the escape sequences we write
+    (only does anything on windows).
+*/
+void enable_escape_sequences(void);
+
+/*
+    Switches to the terminal's alternate screen buffer.
+    The original screen is restored on exit or if we are killed by a signal.
+*/
+void enter_alternate_screen(void);
+
+/*
+    Restores the original screen, does nothing if we never left it.
+*/
+void leave_alternate_screen(void);
+
 /*
     Sleeps for the given amount of time.
 */
@@ -55,6 +75,8 @@ wchar_t *select_str_unicode(wchar_t *unicode, wchar_t *backup);
 
 bool str_icase_eql(char *a, char *b);
 bool atob(char *str);
+// for string environment variables, they are used as is
+char *str_identity(char *str);
 bool supports_unicode(void);
 
 void assert_msg(bool expr, char *fmt, ...);
@@ -3,10 +3,14 @@
 
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdio.h>
 
 #include "helper.h"
 #include "types/shared_types.h"
 #include "types/collection_skeleton.h"
+#include "types/theme.h"
+#include "types/sink.h"
+#include "types/allocator.h"
 
 /* This is the main header to import, by importing this you get everything
    you need to build an example/demonstration of LLV except for the collections.
@@ -52,6 +56,44 @@
         )
 
 #   define NEW_NODE(type, data) type##_new_node(GET_DATA(data), GET_DATA_TYPE(data))
+
+    // `arr` is a typed C array (or pointer), i.e. `DATA_ARRAY(((int[]){1, 2, 3}))`
+#   define DATA_ARRAY(arr)             \
+        ((DataArray){                   \
+            .items = (arr),             \
+            .kind = DATA_ARRAY_KIND(arr), \
+            .tag = DATA_ARRAY_TAG(arr)  \
+        })
+
+    // the DataArrayKind/TypeTag for what `ptr` points to (it isn't evaluated)
+#   define DATA_ARRAY_KIND(ptr)        \
+        _Generic((ptr),                 \
+            char *: DATA_ARRAY_CHAR, \
+            signed char *: DATA_ARRAY_SIGNED_CHAR, \
+            short *: DATA_ARRAY_SHORT, \
+            int *: DATA_ARRAY_INT, \
+            long *: DATA_ARRAY_LONG, \
+            long long *: DATA_ARRAY_LONG_LONG, \
+            unsigned char *: DATA_ARRAY_UNSIGNED_CHAR, \
+            unsigned short *: DATA_ARRAY_UNSIGNED_SHORT, \
+            unsigned int *: DATA_ARRAY_UNSIGNED_INT, \
+            unsigned long *: DATA_ARRAY_UNSIGNED_LONG, \
+            unsigned long long *: DATA_ARRAY_UNSIGNED_LONG_LONG, \
+            float *: DATA_ARRAY_FLOAT, \
+            double *: DATA_ARRAY_DOUBLE, \
+            char **: DATA_ARRAY_STR, \
+            const char **: DATA_ARRAY_STR, \
+            void **: DATA_ARRAY_ANY \
+        )
+#   define DATA_ARRAY_TAG(ptr)         \
+        _Generic((ptr),                 \
+            float *: FLOAT, \
+            double *: FLOAT, \
+            char **: STRING, \
+            const char **: STRING, \
+            void **: ANY, \
+            default: INTEGER \
+        )
 #endif
 
 #define SET_PTR(node, value) if ((node) != NULL) (node)->ptr = value;
@@ -62,6 +104,32 @@ void update_wait(void);
 void fmt_update(char *fmt, ...);
 void clear_screen(void);
 
+/*
+    The environment variables (LLV_PRINT_HEIGHT and friends) are read once
+    and cached, call this if you change them while running.
+*/
+void llv_config_reload(void);
+
+/*
+    Headless mode (or LLV_HEADLESS=1) is for generating frames in bulk;
+    `update_wait` never sleeps or waits for enter, the screen is never
+    cleared and the terminal size is always LLV_DEFAULT_TERM_WIDTH/HEIGHT.
+    Frames go to the current sink (see types/sink.h) as fast as we can make them.
+*/
+void llv_set_headless(bool headless);
+bool llv_headless(void);
+
+/*
+    Where `fmt_update`'s %i* reads come from, by default stdin
+    (NULL goes back to stdin).
+*/
+void llv_set_input(FILE *input);
+
+/*
+    True once a read from the input has run out of data.
+*/
+bool llv_input_eof(void);
+
 void attach_ptr(void *node, char *ptr);
 bool deattach_ptr(void *node, char *ptr);
 
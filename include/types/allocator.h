@@ -0,0 +1,83 @@
+#ifndef LLV_ALLOCATOR_H
+#define LLV_ALLOCATOR_H
+
+#include <stdlib.h>
+
+/*
+    Where collections get their memory from.
+    By default that is malloc/realloc/free but you can hand LLV your own
+    allocator, or use the bundled arena so a whole demo (collections, nodes
+    and any strings you make with `llv_strdup`) goes away in one reset.
+
+    Each collection remembers the allocator that was current when it was
+    made and uses it for itself and its storage (i.e. a List's buffer).
+    LL/DLL nodes come from pools that take their slabs from the current
+    allocator and only move to a new one once all their nodes are given back.
+    LLV's own buffers (frames, sinks, layout scratch) always use malloc.
+*/
+typedef struct _llv_allocator_t *LLVAllocator;
+
+struct _llv_allocator_t {
+    // NULL if it can't (LLV then exits with an OOM error)
+    void *(*alloc)(void *ctx, size_t size);
+    // `ptr` may be NULL in which case `old_size` is 0
+    void *(*realloc)(void *ctx, void *ptr, size_t old_size, size_t new_size);
+    void (*free)(void *ctx, void *ptr, size_t size);
+    void *ctx;
+};
+
+/*
+    malloc/realloc/free, the default.
+*/
+LLVAllocator llv_malloc_allocator(void);
+
+/*
+    The allocator new collections (and node slabs) will use.
+*/
+LLVAllocator llv_allocator(void);
+
+/*
+    Use `allocator` from now on (NULL goes back to malloc),
+    the previous allocator is returned.
+*/
+LLVAllocator llv_set_allocator(LLVAllocator allocator);
+
+/*
+    Allocate, reallocate or free through `allocator` (NULL is the current one).
+    Running out of memory prints `obj_name` and exits, same as malloc_with_oom.
+*/
+void *llv_alloc(LLVAllocator allocator, size_t size, char *obj_name);
+void *llv_realloc(LLVAllocator allocator, void *ptr, size_t old_size, size_t new_size,
+                  char *obj_name);
+void llv_free(LLVAllocator allocator, void *ptr, size_t size);
+
+/*
+    A copy of `str` from `allocator` (NULL is the current one).
+*/
+char *llv_strdup(LLVAllocator allocator, const char *str);
+
+/*
+    A bump allocator that takes `block_size` (0 for a default of 64k) byte
+    blocks from malloc and hands them out in order.  Frees only give memory
+    back if they are of the most recent allocation.
+*/
+LLVAllocator llv_arena_new(size_t block_size);
+
+/*
+    Throws away everything allocated from the arena but keeps its blocks
+    for next time.  Any collection, node or string from it is now invalid.
+*/
+void llv_arena_reset(LLVAllocator arena);
+
+/*
+    Bytes handed out since the last reset (including alignment padding).
+*/
+size_t llv_arena_used(LLVAllocator arena);
+
+/*
+    Resets the arena and gives its blocks back to malloc.
+    If it is the current allocator malloc is used from now on.
+*/
+void llv_arena_free(LLVAllocator arena);
+
+#endif /* LLV_ALLOCATOR_H */
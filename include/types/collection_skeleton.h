@@ -3,6 +3,8 @@
 
 #include <stdlib.h>
 
+#include "allocator.h"
+
 typedef struct _collection_t *Collection;
 
 typedef void(*fn_print_node)(void *n, wchar_t **buf, int size, int len, int offset);
@@ -19,6 +21,7 @@ struct _collection_t {
     fn_print_node node_printer;
     fn_sizeof_node get_sizeof;
     fn_print_list list_printer;
+    LLVAllocator allocator;        // the collection and its storage come from here
 };
 
 #endif /* LLV_COLLECTION_SKELETON_H */
@@ -0,0 +1,27 @@
+#ifndef LLV_COLUMNS_H
+#define LLV_COLUMNS_H
+
+#include "shared_types.h"
+
+/*
+    Struct of arrays storage for Arrays and Lists (see `array_new_soa` and
+    `list_new_soa`).  Rather than a 24 byte node per element we keep a dense
+    column of Data, a 1 byte tag column that only exists once the elements
+    stop all being the same type and a side table for the few that are labelled.
+*/
+
+struct _data_label_t {
+    int index;
+    char *ptr;
+};
+
+typedef struct _data_columns_t {
+    Data *data;
+    unsigned char *tags;    // NULL while every element is a `tag`
+    TypeTag tag;
+    struct _data_label_t *labels; // sorted by index
+    int label_len;
+    int label_capacity;
+} *DataColumns;
+
+#endif /* LLV_COLUMNS_H */
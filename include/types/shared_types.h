@@ -41,4 +41,56 @@ Data data_flt(double data);
 Data data_str(char *data);
 Data data_any(void *data);
 
+// what a DataArray's items really are
+typedef enum _data_array_kind {
+    DATA_ARRAY_DATA,
+    DATA_ARRAY_CHAR,
+    DATA_ARRAY_SIGNED_CHAR,
+    DATA_ARRAY_SHORT,
+    DATA_ARRAY_INT,
+    DATA_ARRAY_LONG,
+    DATA_ARRAY_LONG_LONG,
+    DATA_ARRAY_UNSIGNED_CHAR,
+    DATA_ARRAY_UNSIGNED_SHORT,
+    DATA_ARRAY_UNSIGNED_INT,
+    DATA_ARRAY_UNSIGNED_LONG,
+    DATA_ARRAY_UNSIGNED_LONG_LONG,
+    DATA_ARRAY_FLOAT,
+    DATA_ARRAY_DOUBLE,
+    DATA_ARRAY_STR,
+    DATA_ARRAY_ANY,
+} DataArrayKind;
+
+/*
+    A C array of values that are all the same type, for the bulk functions
+    (i.e. `ll_append_n`).  Use `data_array` for an array of Data or the
+    DATA_ARRAY macro (see llv.h) for a typed array like `int[]`.
+*/
+typedef struct _data_array_t {
+    const void *items;
+    DataArrayKind kind;
+    TypeTag tag;
+} DataArray;
+
+/*
+    Orders two values for sorting, negative if `a` goes first,
+    positive if `b` does and 0 if they are equal.
+*/
+typedef int(*fn_data_compare)(Data a, TypeTag a_tag, Data b, TypeTag b_tag);
+
+/*
+    The default order; numbers (integers and floats mixed) by value,
+    then strings by strcmp, then anything else by address.
+*/
+int data_compare(Data a, TypeTag a_tag, Data b, TypeTag b_tag);
+
+DataArray data_array(const Data *data, TypeTag tag);
+Data data_array_at(DataArray array, int index);
+
+/*
+    Reads element `index` of a C array of one known type (see
+    collections/typed.h), the tag is fixed so it isn't stored per element.
+*/
+typedef Data(*fn_typed_read)(const void *items, int index);
+
 #endif /* LLV_SHARED_TYPES_H */
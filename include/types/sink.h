@@ -0,0 +1,109 @@
+#ifndef LLV_SINK_H
+#define LLV_SINK_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+
+/*
+    Everything LLV prints goes to a sink.
+    By default that is the terminal (stdout) but you can redirect it to a file
+    or a memory buffer, or use a tee to send it to two sinks at once
+    (each frame is only rendered once regardless of how many sinks see it).
+
+    Setting LLV_RECORD_FILE tees the default output into that file,
+    LLV_ASCIICAST_FILE and LLV_GIF_FILE do the same with an asciicast
+    recording and an animated gif.
+*/
+typedef struct _llv_sink_t *LLVSink;
+
+struct _llv_sink_t {
+    // text that isn't part of a frame (prompts, errors)
+    void (*write)(LLVSink sink, const char *bytes, size_t len);
+    // a complete frame, `clear` is set if the screen should be cleared first
+    void (*write_frame)(LLVSink sink, const char *bytes, size_t len, bool clear);
+    void (*flush)(LLVSink sink);
+    // flushes and frees the sink (and any sinks it wraps)
+    void (*close)(LLVSink sink);
+    void *ctx;
+};
+
+/*
+    The terminal, only this sink uses LLV_INCREMENTAL_OUTPUT
+    and LLV_ALTERNATE_SCREEN.  Closing it does nothing.
+*/
+LLVSink llv_stdout_sink(void);
+
+/*
+    Writes everything to `file` as a terminal would see it with full redraws.
+    If `close_file` is set the file is closed along with the sink.
+*/
+LLVSink llv_file_sink(FILE *file, bool close_file);
+
+/*
+    Opens `path` for writing and returns a sink for it, NULL if it can't.
+*/
+LLVSink llv_open_file_sink(const char *path);
+
+/*
+    Writes into the caller's buffer, which is kept null terminated.
+    Output beyond `capacity - 1` bytes is dropped, `len` (if not NULL)
+    is kept up to date with the number of bytes written.
+*/
+LLVSink llv_memory_sink(char *buf, size_t capacity, size_t *len);
+
+/*
+    Sends everything to both `first` and `second`.
+*/
+LLVSink llv_tee_sink(LLVSink first, LLVSink second);
+
+/*
+    Records an asciicast (v2) of every frame, with timestamps, to `file`.
+    Each frame is played back as a full screen; output is buffered
+    and flushed on close, flush or exit.
+*/
+LLVSink llv_asciicast_sink(FILE *file, bool close_file);
+
+/*
+    Opens `path` for writing and returns an asciicast sink for it, NULL if it can't.
+*/
+LLVSink llv_open_asciicast_sink(const char *path);
+
+/*
+    Starts recording everything sent to the current sink as an asciicast
+    at `path`, returns false if it can't be opened.
+*/
+bool llv_record_asciicast(const char *path);
+
+/*
+    Renders every frame into an animated gif written to `file` as it goes,
+    it is finished off when the sink is closed (or at exit).  Frames are shown
+    for LLV_SLEEP_TIME (or a second if it isn't set), text is drawn with a
+    small built in font.
+*/
+LLVSink llv_gif_sink(FILE *file, bool close_file);
+
+/*
+    Opens `path` for writing and returns a gif sink for it, NULL if it can't.
+*/
+LLVSink llv_open_gif_sink(const char *path);
+
+/*
+    Starts recording everything sent to the current sink as a gif
+    at `path`, returns false if it can't be opened.
+*/
+bool llv_record_gif(const char *path);
+
+/*
+    The sink currently in use, the first call creates the default one.
+*/
+LLVSink llv_sink(void);
+
+/*
+    Use `sink` for all future output (NULL goes back to the default).
+    The previous sink is returned and not closed; unless it was the default
+    sink it is yours to close.
+*/
+LLVSink llv_set_sink(LLVSink sink);
+
+#endif /* LLV_SINK_H */
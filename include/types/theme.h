@@ -0,0 +1,48 @@
+#ifndef LLV_THEME_H
+#define LLV_THEME_H
+
+#include <stdlib.h>
+#include <wchar.h>
+
+/*
+    All the glyphs used to draw collections.
+    The built in ascii/unicode themes are chosen between automatically
+    (based on LANG/LLV_DISABLE_UNICODE/LLV_FORCE_UNICODE) but you can
+    supply your own through `llv_set_theme`.
+*/
+typedef struct _llv_theme_t *LLVTheme;
+
+struct _llv_theme_t {
+    wchar_t box_horizontal;
+    wchar_t box_vert;
+    wchar_t box_top_left;
+    wchar_t box_top_right;
+    wchar_t box_bottom_left;
+    wchar_t box_bottom_right;
+    wchar_t ptr_symbol;
+
+    wchar_t *ll_after_node;     // between two nodes of a singly linked list
+    wchar_t *ll_end_of_list;    // after the last node (includes the null node)
+    wchar_t *ll_ellipses;       // where the list is cut off
+
+    wchar_t *dll_after_node;
+    wchar_t *dll_start_of_list;
+    wchar_t *dll_end_of_list;
+    wchar_t *dll_ellipses;
+};
+
+extern struct _llv_theme_t llv_ascii_theme;
+extern struct _llv_theme_t llv_unicode_theme;
+
+/*
+    Returns the theme currently in use, picking one on first use.
+*/
+LLVTheme llv_theme(void);
+
+/*
+    Use the given theme for all future printing, NULL returns to picking
+    one of the built in themes automatically.
+*/
+void llv_set_theme(LLVTheme theme);
+
+#endif /* LLV_THEME_H */
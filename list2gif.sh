@@ -3,6 +3,8 @@
 # Converts the ascii art into gifs
 # You may have to change things like delay/size/font to make it fit/look/work better
 # This is more just a helper than anything
+# Note: running your program with LLV_GIF_FILE=out.gif (and LLV_HEADLESS=1)
+# produces the gif directly without needing ImageMagick
 
 if [ -d tmp ]; then
     rm -r tmp
@@ -0,0 +1,55 @@
+#include "../include/collections/intrusive.h"
+#include "../include/collections/ll.h"
+#include "../include/collections/dll.h"
+#include "../include/llv.h"
+
+struct job {
+    char *name;
+    double cost;
+    struct job *prev;
+    int id;
+    struct job *next;
+};
+
+// an intrusive list has to print exactly the same as the LL/DLL it matches
+int main(void) {
+    static struct job jobs[300];
+    struct job *head = NULL;
+    struct job *tail = NULL;
+
+    IntrusiveList singly = intrusive_new("Jobs", &head, LLV_INTRUSIVE_LL(struct job, next, id));
+    IntrusiveList doubly = intrusive_new("Jobs", &head,
+                                         LLV_INTRUSIVE_DLL(struct job, next, prev, cost));
+    doubly->desc.label_offset = offsetof(struct job, name);
+    update(2, singly, doubly);
+
+    LL ll = ll_new("Jobs");
+    DLL dll = dll_new("Jobs");
+    for (int i = 0; i < 300; i++) {
+        jobs[i] = (struct job){ i % 50 == 1 ? "job" : NULL, i * 0.5, tail, i * 3, NULL };
+        if (tail != NULL) tail->next = &jobs[i];
+        else head = &jobs[i];
+        tail = &jobs[i];
+
+        ll_append(ll, NEW_NODE(ll, i * 3));
+        DLL_Node node = NEW_NODE(dll, i * 0.5);
+        SET_PTR(node, jobs[i].name);
+        dll_append(dll, node);
+
+        if (i == 2) update(4, singly, ll, doubly, dll);
+    }
+    // long lists, with and without the tail to walk back from
+    update(4, singly, ll, doubly, dll);
+    intrusive_set_tail(doubly, &tail);
+    update(2, doubly, dll);
+
+    // changes to the nodes show up next frame
+    head = &jobs[298];
+    jobs[299].id = -1;
+    update(1, singly);
+
+    intrusive_free(singly);
+    intrusive_free(doubly);
+    ll_free(ll);
+    dll_free(dll);
+}
@@ -0,0 +1,27 @@
+#include "../include/collections/list.h"
+#include "../include/collections/array.h"
+#include "../include/llv.h"
+
+// SoA storage has to print exactly the same as the normal layout
+int main(void) {
+    List list = list_new("Nodes");
+    List soa = list_new_soa("Columns", INTEGER);
+    for (int i = 0; i < 40; i++) {
+        struct _list_data_t node = i % 9 == 0 ? NEW_NODE(list, i * 1.5) : NEW_NODE(list, i * 11);
+        if (i % 13 == 0) node.ptr = "i";
+        list_push_back(list, node);
+        list_push_back(soa, node);
+    }
+    list_remove(list, 3);
+    list_remove(soa, 3);
+    update(2, list, soa);
+
+    Array array = array_new_soa("Columns", 6, INTEGER);
+    for (int i = 0; i < 6; i++) array_set(array, i, NEW_NODE(array, i * i));
+    array_set_ptr(array, 2, "j");
+    update(1, array);
+
+    list_free(list);
+    list_free(soa);
+    array_free(array);
+}
@@ -0,0 +1,22 @@
+#include "../include/collections/ll.h"
+#include "../include/llv.h"
+
+int main(void) {
+    LL list = ll_new("Focused");
+    for (int i = 0; i < 50; i++) ll_append(list, NEW_NODE(ll, i * 7));
+
+    LL_Node cur = NULL;
+    attach_ptr(&cur, "cur");
+    ll_set_focus(list, &cur);
+    // nothing to focus on yet so this is the normal head/tail view
+    update(1, list);
+
+    int stops[] = {0, 3, 25, 24, 47, 49};
+    for (int i = 0; i < 6; i++) {
+        cur = list->head;
+        for (int j = 0; j < stops[i]; j++) cur = cur->next;
+        update(1, list);
+    }
+
+    ll_free(list);
+}
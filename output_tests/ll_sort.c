@@ -0,0 +1,10 @@
+#include "../include/collections/ll.h"
+#include "../include/llv.h"
+
+int main(void) {
+    LL list = ll_from_array("Sorting", DATA_ARRAY(((int[]){5, 3, 8, 1, 9, 2, 7, 4, 6, 0})), 10);
+    update(1, list);
+    // 4 merge passes, a frame after every other one and one at the end
+    ll_sort_animated(list, NULL, 2);
+    ll_free(list);
+}
@@ -0,0 +1,33 @@
+#include "../include/collections/ring_queue.h"
+#include "../include/collections/array_stack.h"
+#include "../include/llv.h"
+
+int main(void) {
+    RingQueue queue = ring_queue_new("Queue");
+    ArrayStack stack = array_stack_new("Stack");
+    update(2, queue, stack);
+
+    for (int i = 0; i < 6; i++) {
+        ring_queue_enqueue(queue, NEW_NODE(ring_queue, i * 7));
+        array_stack_push(stack, NEW_NODE(array_stack, i * 7));
+    }
+    SET_PTR(ring_queue_front(queue), "f");
+    SET_PTR(array_stack_top(stack), "t");
+    update(2, queue, stack);
+
+    // wrap the queue around the end of its buffer
+    for (int i = 0; i < 4; i++) ring_queue_dequeue(queue);
+    for (int i = 6; i < 10; i++) ring_queue_enqueue(queue, NEW_NODE(ring_queue, i * 7));
+    array_stack_pop(stack);
+    update(2, queue, stack);
+
+    // too many to fit
+    for (int i = 10; i < 60; i++) {
+        ring_queue_enqueue(queue, NEW_NODE(ring_queue, i * 7));
+        array_stack_push(stack, NEW_NODE(array_stack, i * 7));
+    }
+    update(2, queue, stack);
+
+    ring_queue_free(queue);
+    array_stack_free(stack);
+}
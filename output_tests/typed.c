@@ -0,0 +1,56 @@
+#include "../include/collections/typed.h"
+#include "../include/collections/ll.h"
+#include "../include/collections/list.h"
+#include "../include/llv.h"
+
+LLV_DEFINE_LIST(int)
+LLV_DEFINE_LL(double)
+LLV_DEFINE_ARRAY(str)
+
+// typed collections have to print exactly the same as the normal ones
+int main(void) {
+    List list = list_new("List");
+    List_int typed_list = list_int_new("List");
+    for (int i = 0; i < 40; i++) {
+        list_push_back(list, NEW_NODE(list, i * 11));
+        list_int_push_back(typed_list, i * 11);
+    }
+    update(2, list, typed_list);
+
+    // long enough that only the ends are looked at
+    LL ll = ll_new("LL");
+    LL_double typed_ll = ll_double_new("LL");
+    for (int i = 0; i < 500; i++) {
+        LL_Node node = NEW_NODE(ll, i * 0.5);
+        LL_Node_double typed_node = ll_double_new_node(i * 0.5);
+        if (i == 1 || i == 498) {
+            SET_PTR(node, "cur");
+            SET_PTR(typed_node, "cur");
+        }
+        ll_append(ll, node);
+        ll_double_append(typed_ll, typed_node);
+    }
+    update(2, ll, typed_ll);
+
+    // and short enough to fit
+    ll_clear(ll);
+    ll_double_clear(typed_ll);
+    for (int i = 0; i < 3; i++) {
+        ll_append(ll, NEW_NODE(ll, i * 0.25));
+        ll_double_append(typed_ll, ll_double_new_node(i * 0.25));
+    }
+    update(2, ll, typed_ll);
+
+    Array_str array = array_str_new("Array", 4);
+    *array_str_at(array, 0) = "a";
+    *array_str_at(array, 1) = "bb";
+    *array_str_at(array, 2) = "ccc";
+    *array_str_at(array, 3) = "dddd";
+    update(1, array);
+
+    list_free(list);
+    list_int_free(typed_list);
+    ll_free(ll);
+    ll_double_free(typed_ll);
+    array_str_free(array);
+}
@@ -0,0 +1,218 @@
+#include "../include/types/allocator.h"
+
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "node_pool.h"
+
+/* Malloc */
+
+static void *malloc_allocator_alloc(void *ctx, size_t size) {
+    (void)ctx;
+    return malloc(size);
+}
+
+static void *malloc_allocator_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+    (void)ctx;
+    (void)old_size;
+    return realloc(ptr, new_size);
+}
+
+static void malloc_allocator_free(void *ctx, void *ptr, size_t size) {
+    (void)ctx;
+    (void)size;
+    free(ptr);
+}
+
+static struct _llv_allocator_t malloc_allocator = {
+    malloc_allocator_alloc, malloc_allocator_realloc, malloc_allocator_free, NULL
+};
+
+static LLVAllocator current_allocator = &malloc_allocator;
+
+LLVAllocator llv_malloc_allocator(void) {
+    return &malloc_allocator;
+}
+
+LLVAllocator llv_allocator(void) {
+    return current_allocator;
+}
+
+LLVAllocator llv_set_allocator(LLVAllocator allocator) {
+    LLVAllocator old = current_allocator;
+    current_allocator = allocator != NULL ? allocator : &malloc_allocator;
+    return old;
+}
+
+static void allocator_oom(size_t size, char *obj_name) {
+    printf("Error: OOM; can't allocate %zu bytes for %s\n", size, obj_name);
+    exit(1);
+}
+
+void *llv_alloc(LLVAllocator allocator, size_t size, char *obj_name) {
+    if (allocator == NULL) allocator = current_allocator;
+    void *obj = allocator->alloc(allocator->ctx, size);
+    if (obj == NULL) allocator_oom(size, obj_name);
+    return obj;
+}
+
+void *llv_realloc(LLVAllocator allocator, void *ptr, size_t old_size, size_t new_size,
+                  char *obj_name) {
+    if (allocator == NULL) allocator = current_allocator;
+    void *obj = allocator->realloc(allocator->ctx, ptr, ptr == NULL ? 0 : old_size, new_size);
+    if (obj == NULL && new_size > 0) allocator_oom(new_size, obj_name);
+    return obj;
+}
+
+void llv_free(LLVAllocator allocator, void *ptr, size_t size) {
+    if (ptr == NULL) return;
+    if (allocator == NULL) allocator = current_allocator;
+    allocator->free(allocator->ctx, ptr, size);
+}
+
+char *llv_strdup(LLVAllocator allocator, const char *str) {
+    size_t len = strlen(str) + 1;
+    char *copy = (char*)llv_alloc(allocator, len, "String");
+    memcpy(copy, str, len);
+    return copy;
+}
+
+/* Arena */
+
+#define ARENA_DEFAULT_BLOCK_SIZE (64 * 1024)
+#define ARENA_ALIGN (_Alignof(max_align_t))
+#define ARENA_ROUND_UP(size) (((size) + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1))
+
+// the header is padded out so the memory after it is suitably aligned
+typedef struct _arena_block_t *ArenaBlock;
+struct _arena_block_t {
+    union {
+        struct {
+            ArenaBlock next;
+            size_t capacity;
+            size_t used;
+        } block;
+        max_align_t align;
+    } header;
+};
+
+typedef struct _arena_t {
+    struct _llv_allocator_t allocator;
+    size_t block_size;
+    ArenaBlock first;
+    ArenaBlock cur;
+    // blocks before `cur` count towards this, `cur` doesn't
+    size_t used_before_cur;
+    // the most recent allocation, it alone can grow/shrink in place
+    char *last;
+} *Arena;
+
+static char *arena_block_start(ArenaBlock block) {
+    return (char*)(block + 1);
+}
+
+static ArenaBlock arena_block_new(size_t capacity) {
+    ArenaBlock block = (ArenaBlock)malloc(sizeof(struct _arena_block_t) + capacity);
+    if (block == NULL) return NULL;
+    block->header.block.next = NULL;
+    block->header.block.capacity = capacity;
+    block->header.block.used = 0;
+    return block;
+}
+
+static void *arena_alloc(void *ctx, size_t size) {
+    Arena arena = (Arena)ctx;
+    size = ARENA_ROUND_UP(size);
+    ArenaBlock cur = arena->cur;
+    if (cur == NULL || cur->header.block.capacity - cur->header.block.used < size) {
+        // blocks after `cur` are left over from before a reset so are empty
+        ArenaBlock next = cur == NULL ? arena->first : cur->header.block.next;
+        if (next == NULL || next->header.block.capacity < size) {
+            ArenaBlock block = arena_block_new(size > arena->block_size ? size : arena->block_size);
+            if (block == NULL) return NULL;
+            block->header.block.next = next;
+            if (cur == NULL) arena->first = block;
+            else cur->header.block.next = block;
+            next = block;
+        }
+        if (cur != NULL) arena->used_before_cur += cur->header.block.used;
+        arena->cur = cur = next;
+    }
+
+    char *ptr = arena_block_start(cur) + cur->header.block.used;
+    cur->header.block.used += size;
+    arena->last = ptr;
+    return ptr;
+}
+
+static void *arena_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+    Arena arena = (Arena)ctx;
+    if (ptr == NULL) return arena_alloc(ctx, new_size);
+
+    ArenaBlock cur = arena->cur;
+    if (ptr == arena->last) {
+        size_t offset = (char*)ptr - arena_block_start(cur);
+        size_t rounded = ARENA_ROUND_UP(new_size);
+        if (rounded <= cur->header.block.capacity - offset) {
+            cur->header.block.used = offset + rounded;
+            return ptr;
+        }
+    } else if (new_size <= old_size) {
+        return ptr;
+    }
+
+    void *new_ptr = arena_alloc(ctx, new_size);
+    if (new_ptr != NULL) memcpy(new_ptr, ptr, old_size < new_size ? old_size : new_size);
+    return new_ptr;
+}
+
+static void arena_free(void *ctx, void *ptr, size_t size) {
+    (void)size;
+    Arena arena = (Arena)ctx;
+    if (ptr != arena->last) return;
+    arena->cur->header.block.used = (char*)ptr - arena_block_start(arena->cur);
+    arena->last = NULL;
+}
+
+LLVAllocator llv_arena_new(size_t block_size) {
+    Arena arena = (Arena)malloc(sizeof(struct _arena_t));
+    if (arena == NULL) allocator_oom(sizeof(struct _arena_t), "Arena");
+    arena->allocator = (struct _llv_allocator_t) {
+        arena_alloc, arena_realloc, arena_free, arena
+    };
+    arena->block_size = ARENA_ROUND_UP(block_size > 0 ? block_size : ARENA_DEFAULT_BLOCK_SIZE);
+    arena->first = arena->cur = NULL;
+    arena->used_before_cur = 0;
+    arena->last = NULL;
+    return &arena->allocator;
+}
+
+void llv_arena_reset(LLVAllocator allocator) {
+    Arena arena = (Arena)allocator->ctx;
+    // any node pool drawing from us would hand out memory we are about to reuse
+    node_pool_forget(allocator);
+    for (ArenaBlock block = arena->first; block != NULL; block = block->header.block.next) {
+        block->header.block.used = 0;
+    }
+    arena->cur = arena->first;
+    arena->used_before_cur = 0;
+    arena->last = NULL;
+}
+
+size_t llv_arena_used(LLVAllocator allocator) {
+    Arena arena = (Arena)allocator->ctx;
+    return arena->used_before_cur + (arena->cur != NULL ? arena->cur->header.block.used : 0);
+}
+
+void llv_arena_free(LLVAllocator allocator) {
+    Arena arena = (Arena)allocator->ctx;
+    node_pool_forget(allocator);
+    if (current_allocator == allocator) current_allocator = &malloc_allocator;
+    for (ArenaBlock block = arena->first; block != NULL;) {
+        ArenaBlock next = block->header.block.next;
+        free(block);
+        block = next;
+    }
+    free(arena);
+}
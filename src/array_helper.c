@@ -9,13 +9,43 @@
 
 #include "list_helper.h"
 #include "general_collection_helper.h"
+#include "canvas.h"
+#include "frame.h"
 #include "env_var.h"
+#include "columns_helper.h"
 
-int array_get_sizes(Collection c, FakeArrayNode array, int len, int max, int **node_sizes, int *out_calculated_len) {
+// the first half of the array is sized into the start of `node_sizes` and the
+// second half into its end, `window` is how many we have room for on each side.
+#define NODE_SIZE(node_sizes, window, len, i) \
+    ((node_sizes)[(i) < ((len) + 1) / 2 ? (i) : 2 * (window) - (len) + (i)])
+
+struct _fake_array_data_t array_view_at(ArrayView view, int index) {
+    if (view.nodes != NULL) {
+        return view.nodes[view.wrap > 0 ? (view.start + index) % view.wrap : index];
+    }
+    if (view.columns == NULL) {
+        return (struct _fake_array_data_t) {
+            .ptr = NULL,
+            .data = view.read(view.items, index),
+            .data_tag = view.tag,
+        };
+    }
+    return (struct _fake_array_data_t) {
+        .ptr = columns_label(view.columns, index),
+        .data = columns_data(view.columns, index),
+        .data_tag = columns_tag(view.columns, index),
+    };
+}
+
+int array_get_sizes(Collection c, ArrayView view, int len, int max, int **node_sizes,
+                    int *out_window, int *out_calculated_len) {
     int count = 0;
     *out_calculated_len = 0;
-    if (len == 0) *node_sizes = NULL;
-    else *node_sizes = (int*)malloc_with_oom(sizeof(int) * len, "Node Sizes");
+    // we can't fit more than this many cells from either end so it bounds
+    // the buffer regardless of how long the array is
+    *out_window = list_max_visible(max + WIDTH, WIDTH);
+    int window = *out_window;
+    *node_sizes = list_layout_sizes(2 * window);
 
     // same idea as DLL, go both ways
     int i;
@@ -25,8 +55,9 @@ int array_get_sizes(Collection c, FakeArrayNode array, int len, int max, int **n
     if (len > 0) count = -WIDTH;
 
     for (i = 0; i < (len + 1) / 2; i++) {
-        int forward_size = c->get_sizeof(&array[i]);
-        (*node_sizes)[i] = forward_size;
+        struct _fake_array_data_t node = array_view_at(view, i);
+        int forward_size = c->get_sizeof(&node);
+        NODE_SIZE(*node_sizes, window, len, i) = forward_size;
 
         if (forward_size + count + WIDTH > max) {
             count += ELLIPSES_LEN;
@@ -40,8 +71,9 @@ int array_get_sizes(Collection c, FakeArrayNode array, int len, int max, int **n
 
         if (i == len / 2) break;
 
-        int backward_size = c->get_sizeof(&array[len - 1 - i]);
-        (*node_sizes)[len - 1 - i] = backward_size;
+        node = array_view_at(view, len - 1 - i);
+        int backward_size = c->get_sizeof(&node);
+        NODE_SIZE(*node_sizes, window, len, len - 1 - i) = backward_size;
         if (backward_size + count + WIDTH > max) {
             count += ELLIPSES_LEN;
             if (count > max) mod = 0;
@@ -58,11 +90,11 @@ int array_get_sizes(Collection c, FakeArrayNode array, int len, int max, int **n
         while (count > max) {
             if (mod % 2 == 0) {
                 // we want to undo front
-                count -= (*node_sizes)[i] + WIDTH;
+                count -= NODE_SIZE(*node_sizes, window, len, i) + WIDTH;
             } else {
                 // undo back
                 i--;
-                count -= (*node_sizes)[len - 1 - i] + WIDTH;
+                count -= NODE_SIZE(*node_sizes, window, len, len - 1 - i) + WIDTH;
             }
             (*out_calculated_len)--;
             mod++;
@@ -71,74 +103,57 @@ int array_get_sizes(Collection c, FakeArrayNode array, int len, int max, int **n
 
     if ((*out_calculated_len == 1 && len > 1) ||
         (*out_calculated_len == 0 && len > 0)) {
-        printf("Error: No valid sizing constraint matches terminal size; i.e. increase your terminal size since on current size can't even fit the bare minimum\n");
-        exit(1);
+        exit_too_small_for_terminal();
     }
 
     return count;
 }
 
-void print_array_like(Collection c, char *collection_type, FakeArrayNode data, int len) {
+void print_array_like(Collection c, LLVConfig config, LLVTheme theme, char *collection_type,
+                      ArrayView view, int len) {
     terminalSize size = get_terminal_size();
     int *node_sizes;
+    int window;
     int calculated_len;
-    int count = array_get_sizes(c, data, len, size.width, &node_sizes, &calculated_len);
+    int count = array_get_sizes(c, view, len, size.width, &node_sizes, &window, &calculated_len);
     assert_msg(calculated_len <= len, "array_helper:print_array_like, calculated_len (%d) must be <= len (%d)\n", calculated_len, len);
 
-    int total_height = get_print_height() + get_ptr_height();
-    wchar_t **buf = (wchar_t**)malloc_with_oom(sizeof(wchar_t*) * total_height, "Buffer");
-    for (int i = 0; i < total_height; i++) {
-        buf[i] = (wchar_t*)malloc_with_oom((count + 1) * sizeof(wchar_t), "Buffer");
-        for (int j = 0; j < count; j++) buf[i][j] = ' ';
-        buf[i][count] = '\0';
-    }
+    Canvas canvas = canvas_shared();
+    wchar_t **buf = canvas_reset(canvas, count, config->print_height + config->ptr_height);
 
     int front_len = calculated_len == len ? calculated_len : (calculated_len + 1) / 2;
     int offset = 0;
     for (int i = 0; i < front_len; i++) {
         if (i != 0) {
-            write_str_repeat_char_grid(buf, offset, ' ', get_print_height(), WIDTH, 0);
+            write_str_repeat_char_grid(buf, offset, ' ', config->print_height, WIDTH, 0);
             offset += WIDTH;
         }
-        list_print_node(&data[i], buf, node_sizes[i], get_print_height(), offset);
-        offset += node_sizes[i];
+        int node_size = NODE_SIZE(node_sizes, window, len, i);
+        struct _fake_array_data_t node = array_view_at(view, i);
+        list_draw_node(&node, buf, node_size, config->print_height, offset, config, theme);
+        offset += node_size;
     }
 
     if (front_len != calculated_len) {
         // do middle/ellipses
-        write_str_center_incr(buf, &offset, get_print_height(), ELLIPSES, ELLIPSES_LEN);
+        write_str_center_incr(buf, &offset, config->print_height, ELLIPSES, ELLIPSES_LEN);
 
         // do back side
         for (int i = len - calculated_len / 2; i < len; i++) {
-            write_str_repeat_char_grid(buf, offset, ' ', get_print_height(), WIDTH, 0);
+            write_str_repeat_char_grid(buf, offset, ' ', config->print_height, WIDTH, 0);
             offset += WIDTH;
-            list_print_node(&data[i], buf, node_sizes[i], get_print_height(), offset);
-            offset += node_sizes[i];
+            int node_size = NODE_SIZE(node_sizes, window, len, i);
+            struct _fake_array_data_t node = array_view_at(view, i);
+            list_draw_node(&node, buf, node_size, config->print_height, offset, config, theme);
+            offset += node_size;
         }
     }
 
-    printf("%s: %s\n", collection_type, c->name);
-    for (int i = 0; i < get_print_height(); i++) {
-        printf("%ls\n", buf[i]);
-        free(buf[i]);
-    }
-    for (int i = get_print_height(); i < total_height; i++) {
-        bool found_non_space = false;
-        for (int j = 0; j < count; j++) {
-            if (buf[i][j] != ' ') {
-                found_non_space = true;
-                break;
-            }
-        }
-        if (found_non_space) printf("%ls\n", buf[i]);
-        free(buf[i]);
-    }
+    frame_printf("%s: %s\n", collection_type, c->name);
+    canvas_print(canvas, config->print_height, true);
 
     assert_msg(offset == count, "array_helper:print_array_like, "
                                 "we promised to print out %d characters and "
                                 "printed out just %d\n", count, offset);
-    printf("\n");
-
-    free(buf);
-    free(node_sizes);
+    frame_write("\n", 1);
 }
@@ -5,7 +5,10 @@
 
 #include "../include/types/collection_skeleton.h"
 #include "../include/types/shared_types.h"
+#include "../include/types/theme.h"
+#include "../include/types/columns.h"
 #include "../include/helper.h"
+#include "env_var.h"
 
 /*
     valid values for WIDTH
@@ -25,6 +28,25 @@ struct _fake_array_data_t {
 
 typedef struct _fake_array_data_t *FakeArrayNode;
 
-void print_array_like(Collection c, char *collection_type, FakeArrayNode data, int len);
+/*
+    Where the printer reads elements from; `nodes` for the normal layout,
+    `columns` (with `nodes` NULL) for SoA storage or `items` through `read`
+    (with both NULL) for typed collections whose elements are all `tag`.
+    If `wrap` is set `nodes` is a ring buffer of that many starting at `start`.
+*/
+typedef struct _array_view_t {
+    FakeArrayNode nodes;
+    DataColumns columns;
+    const void *items;
+    fn_typed_read read;
+    TypeTag tag;
+    int start;
+    int wrap;
+} ArrayView;
+
+struct _fake_array_data_t array_view_at(ArrayView view, int index);
+
+void print_array_like(Collection c, LLVConfig config, LLVTheme theme, char *collection_type,
+                      ArrayView view, int len);
 
 #endif /* LLV_ARRAY_HELPER */
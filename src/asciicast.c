@@ -0,0 +1,180 @@
+#include "../include/types/sink.h"
+
+#include <string.h>
+#include <time.h>
+
+#include "../include/helper.h"
+
+#ifdef WINDOWS_COMPATIBILITY
+    #include <windows.h>
+#endif
+
+// we only hit the file once we've built up this much
+#define ASCIICAST_FLUSH_AT (1 << 16)
+
+typedef struct _asciicast_sink_t {
+    FILE *file;
+    bool close_file;
+    double start;
+    char *buf;
+    size_t len;
+    size_t capacity;
+    struct _asciicast_sink_t *next;
+} *AsciicastSink;
+
+// so recordings are complete even if the sink is never closed
+static AsciicastSink open_casts = NULL;
+
+static double asciicast_now(void) {
+    #ifdef WINDOWS_COMPATIBILITY
+        LARGE_INTEGER freq, count;
+        QueryPerformanceFrequency(&freq);
+        QueryPerformanceCounter(&count);
+        return (double)count.QuadPart / freq.QuadPart;
+    #else
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return now.tv_sec + now.tv_nsec / 1e9;
+    #endif
+}
+
+static void asciicast_reserve(AsciicastSink cast, size_t extra) {
+    if (cast->len + extra <= cast->capacity) return;
+    size_t new_capacity = cast->capacity == 0 ? 4096 : cast->capacity * 2;
+    while (new_capacity < cast->len + extra) new_capacity *= 2;
+    char *buf = (char*)malloc_with_oom(new_capacity, "Asciicast Buffer");
+    if (cast->len > 0) memcpy(buf, cast->buf, cast->len);
+    free(cast->buf);
+    cast->buf = buf;
+    cast->capacity = new_capacity;
+}
+
+static void asciicast_flush_buf(AsciicastSink cast) {
+    if (cast->len == 0) return;
+    fwrite(cast->buf, 1, cast->len, cast->file);
+    cast->len = 0;
+}
+
+static void asciicast_flush_all(void) {
+    for (AsciicastSink cast = open_casts; cast != NULL; cast = cast->next) {
+        asciicast_flush_buf(cast);
+        fflush(cast->file);
+    }
+}
+
+// appends `bytes` as the inside of a json string, the terminal would turn
+// '\n' into "\r\n" for us so we do it here too
+static void asciicast_append_escaped(AsciicastSink cast, const char *bytes, size_t len) {
+    // worst case is every byte becoming \u00XX (+1 for sprintf's '\0')
+    asciicast_reserve(cast, len * 6 + 1);
+    char *out = cast->buf + cast->len;
+    for (size_t i = 0; i < len; i++) {
+        unsigned char c = (unsigned char)bytes[i];
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            *out++ = c;
+            continue;
+        }
+
+        *out++ = '\\';
+        switch (c) {
+            case '"': *out++ = '"'; break;
+            case '\\': *out++ = '\\'; break;
+            case '\t': *out++ = 't'; break;
+            case '\r': *out++ = 'r'; break;
+            case '\n': {
+                *out++ = 'r';
+                *out++ = '\\';
+                *out++ = 'n';
+            } break;
+            default: {
+                out += sprintf(out, "u%04x", c);
+            } break;
+        }
+    }
+    cast->len = out - cast->buf;
+}
+
+static void asciicast_event(AsciicastSink cast, const char *prefix,
+                            const char *bytes, size_t len) {
+    char head[64];
+    int head_len = snprintf(head, sizeof(head), "[%.6f, \"o\", \"",
+                            asciicast_now() - cast->start);
+    asciicast_reserve(cast, head_len);
+    memcpy(cast->buf + cast->len, head, head_len);
+    cast->len += head_len;
+
+    if (prefix != NULL) asciicast_append_escaped(cast, prefix, strlen(prefix));
+    asciicast_append_escaped(cast, bytes, len);
+
+    asciicast_reserve(cast, 3);
+    memcpy(cast->buf + cast->len, "\"]\n", 3);
+    cast->len += 3;
+
+    if (cast->len >= ASCIICAST_FLUSH_AT) asciicast_flush_buf(cast);
+}
+
+static void asciicast_sink_write(LLVSink sink, const char *bytes, size_t len) {
+    asciicast_event((AsciicastSink)sink->ctx, NULL, bytes, len);
+}
+
+static void asciicast_sink_write_frame(LLVSink sink, const char *bytes, size_t len, bool clear) {
+    // a recording is played back as an animation so each frame replaces
+    // the last regardless of whether the terminal was cleared
+    asciicast_event((AsciicastSink)sink->ctx, "\x1b[H\x1b[2J", bytes, len);
+}
+
+static void asciicast_sink_flush(LLVSink sink) {
+    AsciicastSink cast = (AsciicastSink)sink->ctx;
+    asciicast_flush_buf(cast);
+    fflush(cast->file);
+}
+
+static void asciicast_sink_close(LLVSink sink) {
+    AsciicastSink cast = (AsciicastSink)sink->ctx;
+    asciicast_flush_buf(cast);
+    if (cast->close_file) fclose(cast->file);
+    else fflush(cast->file);
+
+    AsciicastSink *link = &open_casts;
+    while (*link != cast) link = &(*link)->next;
+    *link = cast->next;
+    free(cast->buf);
+    free(cast);
+    free(sink);
+}
+
+LLVSink llv_asciicast_sink(FILE *file, bool close_file) {
+    AsciicastSink ctx = (AsciicastSink)malloc_with_oom(sizeof(struct _asciicast_sink_t),
+                                                       "Asciicast Sink");
+    ctx->file = file;
+    ctx->close_file = close_file;
+    ctx->start = asciicast_now();
+    ctx->buf = NULL;
+    ctx->len = ctx->capacity = 0;
+
+    terminalSize size = get_terminal_size();
+    fprintf(file, "{\"version\": 2, \"width\": %d, \"height\": %d, \"timestamp\": %lld}\n",
+            size.width, size.height, (long long)time(NULL));
+
+    static bool registered = false;
+    if (!registered) {
+        registered = true;
+        atexit(asciicast_flush_all);
+    }
+    ctx->next = open_casts;
+    open_casts = ctx;
+
+    LLVSink sink = (LLVSink)malloc_with_oom(sizeof(struct _llv_sink_t), "Sink");
+    sink->ctx = ctx;
+    sink->write = asciicast_sink_write;
+    sink->write_frame = asciicast_sink_write_frame;
+    sink->flush = asciicast_sink_flush;
+    sink->close = asciicast_sink_close;
+    return sink;
+}
+
+LLVSink llv_open_asciicast_sink(const char *path) {
+    FILE *file = fopen(path, "w");
+    if (file == NULL) return NULL;
+    return llv_asciicast_sink(file, true);
+}
@@ -0,0 +1,265 @@
+#include "bitmap_font.h"
+
+#include <string.h>
+#include <stdlib.h>
+
+#define GLYPH_WIDTH (5)
+#define GLYPH_HEIGHT (7)
+// where the 5x7 glyphs sit within a cell
+#define GLYPH_TOP (1)
+// the centre of a cell, lines run through here so they meet their neighbours
+#define MID_X (2)
+#define MID_Y (4)
+
+/*
+    Each glyph is 5 columns, bit 0 of each column is the top row.
+    Starts at ' ' and ends at '~'.
+*/
+static const unsigned char font_5x7[][GLYPH_WIDTH] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00}, // ' '
+    {0x00, 0x00, 0x5F, 0x00, 0x00}, // !
+    {0x00, 0x07, 0x00, 0x07, 0x00}, // "
+    {0x14, 0x7F, 0x14, 0x7F, 0x14}, // #
+    {0x24, 0x2A, 0x7F, 0x2A, 0x12}, // $
+    {0x23, 0x13, 0x08, 0x64, 0x62}, // %
+    {0x36, 0x49, 0x55, 0x22, 0x50}, // &
+    {0x00, 0x05, 0x03, 0x00, 0x00}, // '
+    {0x00, 0x1C, 0x22, 0x41, 0x00}, // (
+    {0x00, 0x41, 0x22, 0x1C, 0x00}, // )
+    {0x08, 0x2A, 0x1C, 0x2A, 0x08}, // *
+    {0x08, 0x08, 0x3E, 0x08, 0x08}, // +
+    {0x00, 0x50, 0x30, 0x00, 0x00}, // ,
+    {0x08, 0x08, 0x08, 0x08, 0x08}, // -
+    {0x00, 0x60, 0x60, 0x00, 0x00}, // .
+    {0x20, 0x10, 0x08, 0x04, 0x02}, // /
+    {0x3E, 0x51, 0x49, 0x45, 0x3E}, // 0
+    {0x00, 0x42, 0x7F, 0x40, 0x00}, // 1
+    {0x42, 0x61, 0x51, 0x49, 0x46}, // 2
+    {0x21, 0x41, 0x45, 0x4B, 0x31}, // 3
+    {0x18, 0x14, 0x12, 0x7F, 0x10}, // 4
+    {0x27, 0x45, 0x45, 0x45, 0x39}, // 5
+    {0x3C, 0x4A, 0x49, 0x49, 0x30}, // 6
+    {0x01, 0x71, 0x09, 0x05, 0x03}, // 7
+    {0x36, 0x49, 0x49, 0x49, 0x36}, // 8
+    {0x06, 0x49, 0x49, 0x29, 0x1E}, // 9
+    {0x00, 0x36, 0x36, 0x00, 0x00}, // :
+    {0x00, 0x56, 0x36, 0x00, 0x00}, // ;
+    {0x08, 0x14, 0x22, 0x41, 0x00}, // <
+    {0x14, 0x14, 0x14, 0x14, 0x14}, // =
+    {0x00, 0x41, 0x22, 0x14, 0x08}, // >
+    {0x02, 0x01, 0x51, 0x09, 0x06}, // ?
+    {0x32, 0x49, 0x79, 0x41, 0x3E}, // @
+    {0x7E, 0x11, 0x11, 0x11, 0x7E}, // A
+    {0x7F, 0x49, 0x49, 0x49, 0x36}, // B
+    {0x3E, 0x41, 0x41, 0x41, 0x22}, // C
+    {0x7F, 0x41, 0x41, 0x22, 0x1C}, // D
+    {0x7F, 0x49, 0x49, 0x49, 0x41}, // E
+    {0x7F, 0x09, 0x09, 0x09, 0x01}, // F
+    {0x3E, 0x41, 0x49, 0x49, 0x7A}, // G
+    {0x7F, 0x08, 0x08, 0x08, 0x7F}, // H
+    {0x00, 0x41, 0x7F, 0x41, 0x00}, // I
+    {0x20, 0x40, 0x41, 0x3F, 0x01}, // J
+    {0x7F, 0x08, 0x14, 0x22, 0x41}, // K
+    {0x7F, 0x40, 0x40, 0x40, 0x40}, // L
+    {0x7F, 0x02, 0x0C, 0x02, 0x7F}, // M
+    {0x7F, 0x04, 0x08, 0x10, 0x7F}, // N
+    {0x3E, 0x41, 0x41, 0x41, 0x3E}, // O
+    {0x7F, 0x09, 0x09, 0x09, 0x06}, // P
+    {0x3E, 0x41, 0x51, 0x21, 0x5E}, // Q
+    {0x7F, 0x09, 0x19, 0x29, 0x46}, // R
+    {0x46, 0x49, 0x49, 0x49, 0x31}, // S
+    {0x01, 0x01, 0x7F, 0x01, 0x01}, // T
+    {0x3F, 0x40, 0x40, 0x40, 0x3F}, // U
+    {0x1F, 0x20, 0x40, 0x20, 0x1F}, // V
+    {0x3F, 0x40, 0x38, 0x40, 0x3F}, // W
+    {0x63, 0x14, 0x08, 0x14, 0x63}, // X
+    {0x07, 0x08, 0x70, 0x08, 0x07}, // Y
+    {0x61, 0x51, 0x49, 0x45, 0x43}, // Z
+    {0x00, 0x7F, 0x41, 0x41, 0x00}, // [
+    {0x02, 0x04, 0x08, 0x10, 0x20}, // '\'
+    {0x00, 0x41, 0x41, 0x7F, 0x00}, // ]
+    {0x04, 0x02, 0x01, 0x02, 0x04}, // ^
+    {0x40, 0x40, 0x40, 0x40, 0x40}, // _
+    {0x00, 0x01, 0x02, 0x04, 0x00}, // `
+    {0x20, 0x54, 0x54, 0x54, 0x78}, // a
+    {0x7F, 0x48, 0x44, 0x44, 0x38}, // b
+    {0x38, 0x44, 0x44, 0x44, 0x20}, // c
+    {0x38, 0x44, 0x44, 0x48, 0x7F}, // d
+    {0x38, 0x54, 0x54, 0x54, 0x18}, // e
+    {0x08, 0x7E, 0x09, 0x01, 0x02}, // f
+    {0x0C, 0x52, 0x52, 0x52, 0x3E}, // g
+    {0x7F, 0x08, 0x04, 0x04, 0x78}, // h
+    {0x00, 0x44, 0x7D, 0x40, 0x00}, // i
+    {0x20, 0x40, 0x44, 0x3D, 0x00}, // j
+    {0x7F, 0x10, 0x28, 0x44, 0x00}, // k
+    {0x00, 0x41, 0x7F, 0x40, 0x00}, // l
+    {0x7C, 0x04, 0x18, 0x04, 0x78}, // m
+    {0x7C, 0x08, 0x04, 0x04, 0x78}, // n
+    {0x38, 0x44, 0x44, 0x44, 0x38}, // o
+    {0x7C, 0x14, 0x14, 0x14, 0x08}, // p
+    {0x08, 0x14, 0x14, 0x18, 0x7C}, // q
+    {0x7C, 0x08, 0x04, 0x04, 0x08}, // r
+    {0x48, 0x54, 0x54, 0x54, 0x20}, // s
+    {0x04, 0x3F, 0x44, 0x40, 0x20}, // t
+    {0x3C, 0x40, 0x40, 0x20, 0x7C}, // u
+    {0x1C, 0x20, 0x40, 0x20, 0x1C}, // v
+    {0x3C, 0x40, 0x30, 0x40, 0x3C}, // w
+    {0x44, 0x28, 0x10, 0x28, 0x44}, // x
+    {0x0C, 0x50, 0x50, 0x50, 0x3C}, // y
+    {0x44, 0x64, 0x54, 0x4C, 0x44}, // z
+    {0x00, 0x08, 0x36, 0x41, 0x00}, // {
+    {0x00, 0x00, 0x7F, 0x00, 0x00}, // |
+    {0x00, 0x41, 0x36, 0x08, 0x00}, // }
+    {0x08, 0x04, 0x08, 0x10, 0x08}, // ~
+};
+
+// which ways a box drawing character joins up with its neighbours
+enum {
+    JOIN_UP = 1,
+    JOIN_DOWN = 2,
+    JOIN_LEFT = 4,
+    JOIN_RIGHT = 8,
+};
+
+typedef unsigned char (*Cell)[FONT_CELL_WIDTH];
+
+static void font_hline(Cell cell, int y, int x0, int x1) {
+    for (int x = x0; x <= x1; x++) cell[y][x] = 1;
+}
+
+static void font_vline(Cell cell, int x, int y0, int y1) {
+    for (int y = y0; y <= y1; y++) cell[y][x] = 1;
+}
+
+static void font_draw_single(Cell cell, int joins) {
+    if (joins & JOIN_UP) font_vline(cell, MID_X, 0, MID_Y);
+    if (joins & JOIN_DOWN) font_vline(cell, MID_X, MID_Y, FONT_CELL_HEIGHT - 1);
+    if (joins & JOIN_LEFT) font_hline(cell, MID_Y, 0, MID_X);
+    if (joins & JOIN_RIGHT) font_hline(cell, MID_Y, MID_X, FONT_CELL_WIDTH - 1);
+}
+
+/*
+    Double lines are drawn one either side of the centre, for corners the
+    outer line wraps around the inner one.
+*/
+static void font_draw_double(Cell cell, int joins) {
+    const int lo_x = MID_X - 1, hi_x = MID_X + 1;
+    const int lo_y = MID_Y - 1, hi_y = MID_Y + 1;
+    const int right = FONT_CELL_WIDTH - 1, bottom = FONT_CELL_HEIGHT - 1;
+
+    if (joins == (JOIN_LEFT | JOIN_RIGHT)) {
+        font_hline(cell, lo_y, 0, right);
+        font_hline(cell, hi_y, 0, right);
+    } else if (joins == (JOIN_UP | JOIN_DOWN)) {
+        font_vline(cell, lo_x, 0, bottom);
+        font_vline(cell, hi_x, 0, bottom);
+    } else if (joins == (JOIN_RIGHT | JOIN_DOWN)) {
+        font_hline(cell, lo_y, lo_x, right);
+        font_vline(cell, lo_x, lo_y, bottom);
+        font_hline(cell, hi_y, hi_x, right);
+        font_vline(cell, hi_x, hi_y, bottom);
+    } else if (joins == (JOIN_LEFT | JOIN_DOWN)) {
+        font_hline(cell, lo_y, 0, hi_x);
+        font_vline(cell, hi_x, lo_y, bottom);
+        font_hline(cell, hi_y, 0, lo_x);
+        font_vline(cell, lo_x, hi_y, bottom);
+    } else if (joins == (JOIN_RIGHT | JOIN_UP)) {
+        font_hline(cell, hi_y, lo_x, right);
+        font_vline(cell, lo_x, 0, hi_y);
+        font_hline(cell, lo_y, hi_x, right);
+        font_vline(cell, hi_x, 0, lo_y);
+    } else if (joins == (JOIN_LEFT | JOIN_UP)) {
+        font_hline(cell, hi_y, 0, hi_x);
+        font_vline(cell, hi_x, 0, hi_y);
+        font_hline(cell, lo_y, 0, lo_x);
+        font_vline(cell, lo_x, 0, lo_y);
+    }
+}
+
+// a filled arrow head pointing right (-1) or left (1) with its tip at `tip_x`
+static void font_draw_head(Cell cell, int tip_x, int dir, int size) {
+    for (int i = 0; i < size; i++) {
+        font_vline(cell, tip_x + dir * i, MID_Y - i, MID_Y + i);
+    }
+}
+
+static void font_draw_glyph(Cell cell, const unsigned char glyph[GLYPH_WIDTH]) {
+    for (int x = 0; x < GLYPH_WIDTH; x++) {
+        for (int y = 0; y < GLYPH_HEIGHT; y++) {
+            if (glyph[x] & (1 << y)) cell[y + GLYPH_TOP][x] = 1;
+        }
+    }
+}
+
+void bitmap_font_draw(wchar_t c, unsigned char cell[FONT_CELL_HEIGHT][FONT_CELL_WIDTH]) {
+    memset(cell, 0, FONT_CELL_HEIGHT * FONT_CELL_WIDTH);
+    const int right = FONT_CELL_WIDTH - 1;
+
+    if (c >= L' ' && c <= L'~') {
+        font_draw_glyph(cell, font_5x7[c - L' ']);
+        return;
+    }
+
+    switch (c) {
+        case L'─': font_draw_single(cell, JOIN_LEFT | JOIN_RIGHT); break;
+        case L'│': font_draw_single(cell, JOIN_UP | JOIN_DOWN); break;
+        case L'┌': font_draw_single(cell, JOIN_RIGHT | JOIN_DOWN); break;
+        case L'┐': font_draw_single(cell, JOIN_LEFT | JOIN_DOWN); break;
+        case L'└': font_draw_single(cell, JOIN_RIGHT | JOIN_UP); break;
+        case L'┘': font_draw_single(cell, JOIN_LEFT | JOIN_UP); break;
+        case L'├': font_draw_single(cell, JOIN_UP | JOIN_DOWN | JOIN_RIGHT); break;
+        case L'┤': font_draw_single(cell, JOIN_UP | JOIN_DOWN | JOIN_LEFT); break;
+        case L'┬': font_draw_single(cell, JOIN_LEFT | JOIN_RIGHT | JOIN_DOWN); break;
+        case L'┴': font_draw_single(cell, JOIN_LEFT | JOIN_RIGHT | JOIN_UP); break;
+        case L'┼': font_draw_single(cell, JOIN_LEFT | JOIN_RIGHT | JOIN_UP | JOIN_DOWN); break;
+        case L'═': font_draw_double(cell, JOIN_LEFT | JOIN_RIGHT); break;
+        case L'║': font_draw_double(cell, JOIN_UP | JOIN_DOWN); break;
+        case L'╔': font_draw_double(cell, JOIN_RIGHT | JOIN_DOWN); break;
+        case L'╗': font_draw_double(cell, JOIN_LEFT | JOIN_DOWN); break;
+        case L'╚': font_draw_double(cell, JOIN_RIGHT | JOIN_UP); break;
+        case L'╝': font_draw_double(cell, JOIN_LEFT | JOIN_UP); break;
+        case L'⌃':
+        case L'↑': {
+            font_draw_glyph(cell, font_5x7['^' - ' ']);
+            if (c == L'↑') font_vline(cell, MID_X, GLYPH_TOP, GLYPH_TOP + GLYPH_HEIGHT - 1);
+        } break;
+        case L'➢':
+        case L'➤': {
+            font_draw_head(cell, right - 1, -1, 4);
+        } break;
+        case L'→':
+        case L'⟶': {
+            font_hline(cell, MID_Y, 0, right);
+            font_draw_head(cell, right, -1, 3);
+        } break;
+        case L'←':
+        case L'⟵': {
+            font_hline(cell, MID_Y, 0, right);
+            font_draw_head(cell, 0, 1, 3);
+        } break;
+        case L'↔':
+        case L'⟷': {
+            font_hline(cell, MID_Y, 0, right);
+            font_draw_head(cell, 0, 1, 3);
+            font_draw_head(cell, right, -1, 3);
+        } break;
+        case L'⇔':
+        case L'⟺': {
+            font_hline(cell, MID_Y - 1, 1, right - 1);
+            font_hline(cell, MID_Y + 1, 1, right - 1);
+            font_draw_head(cell, 0, 1, 3);
+            font_draw_head(cell, right, -1, 3);
+            // hollow out the middle so it reads as a double line
+            for (int x = 1; x < right; x++) cell[MID_Y][x] = 0;
+        } break;
+        default: {
+            // control characters are just blank
+            if (c < L' ' || c == 0x7F) break;
+            // something we don't know how to draw
+            font_hline(cell, GLYPH_TOP, 0, GLYPH_WIDTH - 1);
+            font_hline(cell, GLYPH_TOP + GLYPH_HEIGHT - 1, 0, GLYPH_WIDTH - 1);
+            font_vline(cell, 0, GLYPH_TOP, GLYPH_TOP + GLYPH_HEIGHT - 1);
+            font_vline(cell, GLYPH_WIDTH - 1, GLYPH_TOP, GLYPH_TOP + GLYPH_HEIGHT - 1);
+        } break;
+    }
+}
@@ -0,0 +1,21 @@
+#ifndef LLV_BITMAP_FONT_H
+#define LLV_BITMAP_FONT_H
+
+#include <wchar.h>
+
+/*
+    A tiny fixed width font for rasterizing frames (see gif.c).
+    Printable ascii comes from a 5x7 bitmap, the box drawing characters and
+    arrows our themes use are drawn so they join up with their neighbours.
+    Anything else is drawn as a hollow box.
+*/
+
+#define FONT_CELL_WIDTH (6)
+#define FONT_CELL_HEIGHT (10)
+
+/*
+    Draws `c` into `cell` (1 is ink, 0 is background), `cell` is cleared first.
+*/
+void bitmap_font_draw(wchar_t c, unsigned char cell[FONT_CELL_HEIGHT][FONT_CELL_WIDTH]);
+
+#endif /* LLV_BITMAP_FONT_H */
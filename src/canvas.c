@@ -0,0 +1,77 @@
+#include "canvas.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../include/helper.h"
+#include "frame.h"
+
+static Canvas shared_canvas = NULL;
+
+Canvas canvas_new(void) {
+    Canvas canvas = (Canvas)malloc_with_oom(sizeof(struct _canvas_t), "Canvas");
+    canvas->cells = NULL;
+    canvas->rows = NULL;
+    canvas->width = canvas->height = 0;
+    canvas->max_width = canvas->max_height = 0;
+    return canvas;
+}
+
+void canvas_free(Canvas canvas) {
+    free(canvas->cells);
+    free(canvas->rows);
+    free(canvas);
+}
+
+Canvas canvas_shared(void) {
+    if (shared_canvas == NULL) shared_canvas = canvas_new();
+    return shared_canvas;
+}
+
+wchar_t **canvas_reset(Canvas canvas, int width, int height) {
+    if (width > canvas->max_width || height > canvas->max_height) {
+        // grow both dimensions together so we don't thrash between frames
+        if (width > canvas->max_width) canvas->max_width = width;
+        if (height > canvas->max_height) canvas->max_height = height;
+
+        free(canvas->cells);
+        free(canvas->rows);
+        canvas->cells = (wchar_t*)malloc_with_oom(sizeof(wchar_t) * (canvas->max_width + 1) *
+                                                  canvas->max_height, "Canvas Cells");
+        canvas->rows = (wchar_t**)malloc_with_oom(sizeof(wchar_t*) * canvas->max_height,
+                                                  "Canvas Rows");
+        for (int i = 0; i < canvas->max_height; i++) {
+            canvas->rows[i] = canvas->cells + i * (canvas->max_width + 1);
+        }
+    }
+
+    canvas->width = width;
+    canvas->height = height;
+    for (int i = 0; i < height; i++) {
+        wmemset(canvas->rows[i], L' ', width);
+        canvas->rows[i][width] = L'\0';
+    }
+    return canvas->rows;
+}
+
+bool canvas_row_is_blank(Canvas canvas, int row) {
+    wchar_t *cells = canvas->rows[row];
+    for (int i = 0; i < canvas->width; i++) {
+        if (cells[i] != L' ') return false;
+    }
+    return true;
+}
+
+static void canvas_print_row(Canvas canvas, int row) {
+    frame_write_wide(canvas->rows[row], canvas->width);
+    frame_write("\n", 1);
+}
+
+void canvas_print(Canvas canvas, int print_height, bool include_ptr_rows) {
+    for (int i = 0; i < print_height; i++) canvas_print_row(canvas, i);
+    if (!include_ptr_rows) return;
+
+    for (int i = print_height; i < canvas->height; i++) {
+        if (!canvas_row_is_blank(canvas, i)) canvas_print_row(canvas, i);
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef LLV_CANVAS_H
+#define LLV_CANVAS_H
+
+#include <stdbool.h>
+#include <wchar.h>
+
+/*
+    A 2D grid of characters that the collection printers draw into.
+    All rows live in one contiguous block (each row null terminated) and the
+    block only ever grows, so once the canvas is big enough for the largest
+    frame we no longer allocate anything.
+*/
+typedef struct _canvas_t *Canvas;
+
+struct _canvas_t {
+    wchar_t *cells;     // max_height rows of (max_width + 1) cells
+    wchar_t **rows;     // rows[i] points to the start of row i in cells
+    int width;          // the size currently in use
+    int height;
+    int max_width;      // the size we have allocated for
+    int max_height;
+};
+
+Canvas canvas_new(void);
+
+void canvas_free(Canvas canvas);
+
+/*
+    The canvas shared by all the collection printers.
+*/
+Canvas canvas_shared(void);
+
+/*
+    Resizes the canvas to width x height (growing the allocation only if
+    needed) and fills it with spaces, returns the rows to draw into.
+*/
+wchar_t **canvas_reset(Canvas canvas, int width, int height);
+
+/*
+    Returns true if the row only contains spaces.
+*/
+bool canvas_row_is_blank(Canvas canvas, int row);
+
+/*
+    Prints out the first `print_height` rows then the remaining (pointer) rows
+    if `include_ptr_rows` is set and they aren't blank.
+*/
+void canvas_print(Canvas canvas, int print_height, bool include_ptr_rows);
+
+#endif /* LLV_CANVAS_H */
@@ -1,13 +1,20 @@
+#include <string.h>
+
 #include "../../include/collections/array.h"
 #include "../list_helper.h"
 #include "../array_helper.h"
+#include "../columns_helper.h"
 
 void array_print(Collection c);
 
-Array array_new(char *name, int size) {
-    Array array = (Array)malloc_with_oom(sizeof(struct _array_t), "Array");
-    array->data = (ArrayNode)malloc_with_oom(sizeof(struct _array_data_t) * size, "Array Nodes");
-    array->len = size;
+// everything but the storage
+static Array array_alloc(char *name) {
+    LLVAllocator allocator = llv_allocator();
+    Array array = (Array)llv_alloc(allocator, sizeof(struct _array_t), "Array");
+    array->parent.allocator = allocator;
+    array->data = NULL;
+    array->columns = NULL;
+    array->len = 0;
     array->parent.get_sizeof = list_sizeof;
     array->parent.node_printer = list_print_node;
     array->parent.list_printer = array_print;
@@ -15,16 +22,66 @@ Array array_new(char *name, int size) {
     return array;
 }
 
+Array array_new(char *name, int size) {
+    Array array = array_alloc(name);
+    array->data = (ArrayNode)llv_alloc(array->parent.allocator,
+                                       sizeof(struct _array_data_t) * size, "Array Nodes");
+    array->len = size;
+    return array;
+}
+
+Array array_new_soa(char *name, int size, TypeTag tag) {
+    Array array = array_alloc(name);
+    array->columns = columns_new(array->parent.allocator, tag);
+    array_resize(array, size);
+    memset(array->columns->data, 0, sizeof(Data) * size);
+    return array;
+}
+
 void array_free(Array array) {
-    free(array->data);
-    free(array);
+    if (array->columns != NULL) columns_free(array->columns, array->parent.allocator, array->len);
+    llv_free(array->parent.allocator, array->data, sizeof(struct _array_data_t) * array->len);
+    llv_free(array->parent.allocator, array, sizeof(struct _array_t));
 }
 
 ArrayNode array_at(Array array, int index) {
+    assert_msg(array->columns == NULL, "array:array_at can't be used on SoA arrays "
+                                       "use array_get instead");
     if (array->len <= index) return NULL;
     return &array->data[index];
 }
 
+Data array_get(Array array, int index) {
+    assert_msg(array->len > index, "array:array_get %d is out of bounds max "
+                                   "index is %d", index, array->len - 1);
+    if (array->columns != NULL) return columns_data(array->columns, index);
+    return array->data[index].data;
+}
+
+TypeTag array_get_tag(Array array, int index) {
+    assert_msg(array->len > index, "array:array_get_tag %d is out of bounds max "
+                                   "index is %d", index, array->len - 1);
+    if (array->columns != NULL) return columns_tag(array->columns, index);
+    return array->data[index].data_tag;
+}
+
+char *array_get_ptr(Array array, int index) {
+    assert_msg(array->len > index, "array:array_get_ptr %d is out of bounds max "
+                                   "index is %d", index, array->len - 1);
+    if (array->columns != NULL) return columns_label(array->columns, index);
+    return array->data[index].ptr;
+}
+
+void array_set_ptr(Array array, int index, char *ptr) {
+    assert_msg(array->len > index, "array:array_set_ptr %d is out of bounds max "
+                                   "index is %d", index, array->len - 1);
+    if (array->columns != NULL) {
+        columns_set_label(array->columns, array->parent.allocator, index, ptr);
+    } else {
+        array->data[index].ptr = ptr;
+    }
+}
+
 struct _array_data_t array_new_node(Data data, TypeTag type) {
     return (struct _array_data_t) {
         .data = data,
@@ -34,14 +91,48 @@ struct _array_data_t array_new_node(Data data, TypeTag type) {
 }
 
 void array_resize(Array array, int new_size) {
-    array->data = (ArrayNode)realloc(array->data, sizeof(struct _array_data_t) * new_size);
+    if (array->columns != NULL) {
+        columns_resize(array->columns, array->parent.allocator, array->len, new_size);
+        array->len = new_size;
+        return;
+    }
+    array->data = (ArrayNode)llv_realloc(array->parent.allocator, array->data,
+                                         sizeof(struct _array_data_t) * array->len,
+                                         sizeof(struct _array_data_t) * new_size, "Array Nodes");
     array->len = new_size;
 }
 
 void array_set(Array array, int index, struct _array_data_t node) {
     assert_msg(array->len > index, "array:array_set %d is out of bounds max "
                                    "index is %d", index, array->len - 1);
-    array->data[index] = node;
+    if (array->columns != NULL) {
+        columns_set(array->columns, array->parent.allocator, array->len, index,
+                    node.data, node.data_tag);
+        columns_set_label(array->columns, array->parent.allocator, index, node.ptr);
+    } else {
+        array->data[index] = node;
+    }
+}
+
+Array array_from_array(char *name, DataArray items, int n) {
+    Array array = array_new(name, n);
+    for (int i = 0; i < n; i++) array->data[i] = array_new_node(data_array_at(items, i), items.tag);
+    return array;
+}
+
+void array_append_n(Array array, DataArray items, int n) {
+    if (n <= 0) return;
+    int old_len = array->len;
+    array_resize(array, old_len + n);
+    if (array->columns != NULL) {
+        for (int i = 0; i < n; i++) {
+            columns_set(array->columns, array->parent.allocator, array->len, old_len + i,
+                        data_array_at(items, i), items.tag);
+        }
+        return;
+    }
+    ArrayNode nodes = array->data + old_len;
+    for (int i = 0; i < n; i++) nodes[i] = array_new_node(data_array_at(items, i), items.tag);
 }
 
 int array_length(Array array) {
@@ -50,5 +141,6 @@ int array_length(Array array) {
 
 void array_print(Collection c) {
     Array array = (Array)c;
-    print_array_like(c, "Array", (FakeArrayNode)array->data, array->len);
+    ArrayView view = { .nodes = (FakeArrayNode)array->data, .columns = array->columns };
+    print_array_like(c, llv_config(), llv_theme(), "Array", view, array->len);
 }
@@ -0,0 +1,104 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "../../include/collections/array_stack.h"
+#include "../../include/helper.h"
+#include "../list_helper.h"
+#include "../array_helper.h"
+
+#define ARRAY_STACK_MIN_CAPACITY (8)
+
+void array_stack_print(Collection c);
+
+ArrayStack array_stack_new(char *name) {
+    LLVAllocator allocator = llv_allocator();
+    ArrayStack stack = (ArrayStack)llv_alloc(allocator, sizeof(struct _array_stack_t),
+                                             "Array Stack");
+    stack->parent.allocator = allocator;
+    stack->parent.name = name;
+    stack->parent.get_sizeof = list_sizeof;
+    stack->parent.node_printer = list_print_node;
+    stack->parent.list_printer = array_stack_print;
+    stack->data = NULL;
+    stack->len = stack->capacity = 0;
+    return stack;
+}
+
+void array_stack_free(ArrayStack stack) {
+    llv_free(stack->parent.allocator, stack->data,
+             sizeof(struct _array_stack_data_t) * stack->capacity);
+    llv_free(stack->parent.allocator, stack, sizeof(struct _array_stack_t));
+}
+
+int array_stack_length(ArrayStack stack) {
+    return stack->len;
+}
+
+bool array_stack_is_empty(ArrayStack stack) {
+    return stack->len == 0;
+}
+
+void array_stack_clear(ArrayStack stack) {
+    stack->len = 0;
+}
+
+void array_stack_reserve(ArrayStack stack, int len) {
+    if (len <= stack->capacity) return;
+    int new_capacity = stack->capacity == 0 ? ARRAY_STACK_MIN_CAPACITY : stack->capacity;
+    while (new_capacity < len) new_capacity *= 2;
+    stack->data = (ArrayStackNode)llv_realloc(stack->parent.allocator, stack->data,
+                                              sizeof(struct _array_stack_data_t) * stack->capacity,
+                                              sizeof(struct _array_stack_data_t) * new_capacity,
+                                              "Array Stack Nodes");
+    stack->capacity = new_capacity;
+}
+
+struct _array_stack_data_t array_stack_new_node(Data data, TypeTag type) {
+    return (struct _array_stack_data_t) {
+        .data = data,
+        .data_tag = type,
+        .ptr = NULL,
+    };
+}
+
+void array_stack_push(ArrayStack stack, struct _array_stack_data_t node) {
+    if (stack->len == stack->capacity) array_stack_reserve(stack, stack->len + 1);
+    stack->data[stack->len++] = node;
+}
+
+ArrayStack array_stack_from_array(char *name, DataArray items, int n) {
+    ArrayStack stack = array_stack_new(name);
+    array_stack_push_n(stack, items, n);
+    return stack;
+}
+
+void array_stack_push_n(ArrayStack stack, DataArray items, int n) {
+    if (n <= 0) return;
+    array_stack_reserve(stack, stack->len + n);
+    for (int i = 0; i < n; i++) {
+        stack->data[stack->len + i] = array_stack_new_node(data_array_at(items, i), items.tag);
+    }
+    stack->len += n;
+}
+
+struct _array_stack_data_t array_stack_pop(ArrayStack stack) {
+    assert_msg(stack->len > 0, "array_stack:array_stack_pop, the stack is empty\n");
+    return stack->data[--stack->len];
+}
+
+ArrayStackNode array_stack_at(ArrayStack stack, int index) {
+    if (index < 0 || index >= stack->len) return NULL;
+    return &stack->data[index];
+}
+
+ArrayStackNode array_stack_top(ArrayStack stack) {
+    return array_stack_at(stack, stack->len - 1);
+}
+
+void array_stack_print(Collection c) {
+    ArrayStack stack = (ArrayStack)c;
+    char title[64];
+    snprintf(title, sizeof(title), "Array Stack (top %d)", stack->len - 1);
+    ArrayView view = { .nodes = (FakeArrayNode)stack->data };
+    print_array_like(c, llv_config(), llv_theme(), title, view, stack->len);
+}
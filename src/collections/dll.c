@@ -7,23 +7,24 @@
 
 #include "../../include/collections/dll.h"
 #include "../../include/helper.h"
+#include "../../include/llv.h"
 #include "../list_helper.h"
+#include "../general_collection_helper.h"
+#include "../node_pool.h"
 
-#define DLL_AFTER_NODE (select_str_unicode(L" ⟺   ", L" <-> "))
-#define DLL_AFTER_NODE_LEN (wcslen(DLL_AFTER_NODE))
-#define DLL_START_OF_LIST (select_str_unicode(NULL_NODE L" ⟺  ", NULL_NODE L" <-> "))
-#define DLL_START_OF_LIST_LEN (wcslen(DLL_START_OF_LIST))
-#define DLL_END_OF_LIST (select_str_unicode(L" ⟺   " NULL_NODE, L" <-> " NULL_NODE))
-#define DLL_END_OF_LIST_LEN (wcslen(DLL_END_OF_LIST))
-#define DLL_ELLIPSES (select_str_unicode(L"... ⟺   ", L"... <-> "))
-#define DLL_ELLIPSES_LEN (wcslen(DLL_ELLIPSES))
+// every DLL node comes from here, see dll_clear
+static struct _node_pool_t dll_node_pool = NODE_POOL_INIT(struct _dll_node_t, "DLL_Node");
 
 void dll_print_list(Collection collection);
 
 DLL dll_new(char *name) {
-    DLL dll = (DLL)malloc_with_oom(sizeof(struct _doubly_linked_list_t), "DLL");
+    LLVAllocator allocator = llv_allocator();
+    DLL dll = (DLL)llv_alloc(allocator, sizeof(struct _doubly_linked_list_t), "DLL");
+    dll->parent.allocator = allocator;
     dll->parent.name = name;
     dll->head = dll->tail = NULL;
+    dll->len = 0;
+    dll->focus = NULL;
     dll->parent.list_printer = dll_print_list;
     dll->parent.get_sizeof = list_sizeof;
     dll->parent.node_printer = list_print_node;
@@ -32,18 +33,18 @@ DLL dll_new(char *name) {
 
 void dll_free(DLL list) {
     dll_clear(list);
-    free(list);
+    llv_free(list->parent.allocator, list, sizeof(struct _doubly_linked_list_t));
 }
 
 void dll_free_node(DLL_Node n) {
     // should help catch any dereferencing memory that can't be accessed.
     n->next = NULL;
     n->prev = NULL;
-    free(n);
+    node_pool_free(&dll_node_pool, n);
 }
 
 DLL_Node dll_new_node(Data data, TypeTag type) {
-    DLL_Node new_node = (DLL_Node)malloc_with_oom(sizeof(struct _dll_node_t), "DLL_Node");
+    DLL_Node new_node = (DLL_Node)node_pool_alloc(&dll_node_pool);
     new_node->next = new_node->prev = NULL;
     new_node->data = data;
     new_node->data_tag = type;
@@ -63,26 +64,132 @@ void dll_append(DLL list, DLL_Node n) {
     dll_insert_after(list, n, list->tail);
 }
 
+DLL dll_from_array(char *name, DataArray items, int n) {
+    DLL list = dll_new(name);
+    dll_append_n(list, items, n);
+    return list;
+}
+
+void dll_append_n(DLL list, DataArray items, int n) {
+    if (n <= 0) return;
+    DLL_Node nodes = (DLL_Node)node_pool_alloc_n(&dll_node_pool, n);
+    for (int i = 0; i < n; i++) {
+        nodes[i].prev = i > 0 ? &nodes[i - 1] : list->tail;
+        nodes[i].next = &nodes[i + 1];
+        nodes[i].data = data_array_at(items, i);
+        nodes[i].data_tag = items.tag;
+        nodes[i].ptr = NULL;
+    }
+    nodes[n - 1].next = NULL;
+
+    if (list->tail == NULL) list->head = nodes;
+    else list->tail->next = nodes;
+    list->tail = &nodes[n - 1];
+    list->len += n;
+}
+
+// the merge sort only keeps `next` right
+static void dll_fix_prev(DLL list, FakeNode head, FakeNode tail) {
+    list->head = (DLL_Node)head;
+    list->tail = (DLL_Node)tail;
+    DLL_Node prev = NULL;
+    for (DLL_Node cur = list->head; cur != NULL; cur = cur->next) {
+        cur->prev = prev;
+        prev = cur;
+    }
+}
+
+static void dll_sort_pass(void *ctx, FakeNode head, FakeNode tail) {
+    DLL list = (DLL)ctx;
+    dll_fix_prev(list, head, tail);
+    update(1, list);
+}
+
+void dll_sort(DLL list, fn_data_compare cmp) {
+    dll_sort_animated(list, cmp, 0);
+}
+
+void dll_sort_animated(DLL list, fn_data_compare cmp, int passes_per_frame) {
+    FakeNode tail;
+    FakeNode head = list_merge_sort((FakeNode)list->head, cmp, &tail, passes_per_frame,
+                                    passes_per_frame > 0 ? dll_sort_pass : NULL, list);
+    dll_fix_prev(list, head, tail);
+}
+
+void dll_concat(DLL list, DLL other) {
+    dll_splice(list, list->tail, other);
+}
+
+void dll_splice(DLL list, DLL_Node at, DLL other) {
+    if (other->head == NULL) return;
+    DLL_Node post_at = at == NULL ? list->head : at->next;
+    other->head->prev = at;
+    other->tail->next = post_at;
+    if (at == NULL) list->head = other->head;
+    else at->next = other->head;
+    if (post_at == NULL) list->tail = other->tail;
+    else post_at->prev = other->tail;
+    list->len += other->len;
+
+    other->head = other->tail = NULL;
+    other->len = 0;
+    other->focus = NULL;
+}
+
+DLL dll_split_at(DLL list, int index, char *name) {
+    DLL rest = dll_new(name);
+    if (index >= list->len) return rest;
+    if (index < 0) index = 0;
+
+    bool keeps_focus = false;
+    DLL_Node before = NULL;
+    for (int i = 0; i < index; i++) {
+        before = before == NULL ? list->head : before->next;
+        keeps_focus = keeps_focus || (list->focus != NULL && *list->focus == before);
+    }
+
+    rest->head = before == NULL ? list->head : before->next;
+    rest->head->prev = NULL;
+    rest->tail = list->tail;
+    rest->len = list->len - index;
+    if (before == NULL) list->head = NULL;
+    else before->next = NULL;
+    list->tail = before;
+    list->len = index;
+    // the focus has to be in the list
+    if (!keeps_focus) list->focus = NULL;
+    return rest;
+}
+
 void dll_clear(DLL list) {
     for (DLL_Node cur = list->head; cur != NULL;) {
         DLL_Node temp = cur;
         cur = cur->next;
-        free(temp);
+        node_pool_free(&dll_node_pool, temp);
     }
+    // only once every node has been given back (by any list or by hand)
+    // can the slabs go, the list's len can't tell us that.
+    if (dll_node_pool.live == 0) node_pool_release(&dll_node_pool);
     list->head = list->tail = NULL;
+    list->len = 0;
+    list->focus = NULL;
 }
 
 void dll_insert_after(DLL list, DLL_Node node, DLL_Node at) {
     node->next = NULL;
     if (at == NULL) {
         list->tail = list->head = node;
+        node->prev = NULL;
+        list->len = 1;
     } else {
+        list->len++;
         DLL_Node post_at = at->next;
         // at -> post_at => at -> node -> post_at;
         node->next = post_at;
         at->next = node;
         node->prev = at;
         if (post_at == NULL) list->tail = node;
+        else post_at->prev = node;
     }
 }
 
@@ -93,11 +200,16 @@ void dll_insert_before(DLL list, DLL_Node node, DLL_Node at) {
         node->next = at;
         if (at != NULL) {
             at->prev = node;
+        } else {
+            list->tail = node;
         }
+        list->len++;
     } else if (at != NULL) {
         at->prev->next = node;
+        node->prev = at->prev;
         node->next = at;
         at->prev = node;
+        list->len++;
     }
 }
 
@@ -122,7 +234,9 @@ DLL_Node dll_remove_node(DLL list, DLL_Node node) {
         node->next->prev = node->prev;
     }
 
+    if (list->focus != NULL && *list->focus == node) list->focus = NULL;
     node->next = node->prev = NULL;
+    list->len--;
     return node;
 }
 
@@ -141,81 +255,100 @@ DLL_Node dll_find_next(DLL_Node n) {
 }
 
 int dll_length(DLL list) {
-    int count = 0;
-    for (DLL_Node n = list->head; n != NULL; n = n->next) count++;
-    return count;
+    return list->len;
 }
 
-int *dll_attempt_fit(DLL list, int len, terminalSize size, int *out_count,
-                    DLL_Node *out_forwards, DLL_Node *out_backwards, int *out_stop) {
-    int *node_sizes = (int*)malloc_with_oom(sizeof(int) * len, "node_sizes");
+void dll_layout(DLL list, terminalSize size, LLVTheme theme, ListLayout layout) {
+    layout->everything_fits = true;
+    layout->hidden_before = layout->hidden_after = false;
+    layout->front_start = (FakeNode)list->head;
+    layout->front_shown = layout->back_shown = 0;
+    layout->front_sizes = layout->back_sizes = NULL;
+    layout->back_start = NULL;
 
     if (dll_is_empty(list)) {
-        *out_stop = 0;
-        *out_count = NULL_NODE_LEN;
-        return node_sizes;
+        layout->count = NULL_NODE_LEN;
+        return;
     }
 
-    *out_count = DLL_START_OF_LIST_LEN + NULL_NODE_LEN + DLL_ELLIPSES_LEN;
-    *out_stop = 0;
-    *out_forwards = list->head;
-    *out_backwards = list->tail;
+    int len = list->len;
+    int after_node_len = wcslen(theme->dll_after_node);
+    int ellipses_len = wcslen(theme->dll_ellipses);
+    // front sizes fill the buffer from the start and back sizes from the end
+    int window = list_max_visible(size.width, after_node_len);
+    int *sizes = list_layout_sizes(2 * window);
+    int count = wcslen(theme->dll_start_of_list) + NULL_NODE_LEN + ellipses_len;
+    DLL_Node forwards = list->head;
+    DLL_Node backwards = list->tail;
 
     // only go through half the list
+    int stop = 0;
     bool broke_due_to_size = false;
-    for (; *out_stop < (len + 1) / 2; (*out_stop)++) {
-        node_sizes[*out_stop] = list->parent.get_sizeof(*out_forwards);
-        int forward_size = node_sizes[*out_stop] + DLL_AFTER_NODE_LEN;
-        if (*out_count + forward_size > size.width) {
+    for (; stop < (len + 1) / 2; stop++) {
+        sizes[stop] = list->parent.get_sizeof(forwards);
+        int forward_size = sizes[stop] + after_node_len;
+        if (count + forward_size > size.width) {
             broke_due_to_size = true;
             break;
         }
 
-        *out_count += forward_size;
-        *out_forwards = (*out_forwards)->next;
+        count += forward_size;
+        forwards = forwards->next;
+        layout->front_shown++;
 
-        if (*out_stop == len / 2) break;
+        if (stop == len / 2) break;
 
-        node_sizes[len - 1 - *out_stop] = list->parent.get_sizeof(*out_backwards);
-        int backward_size = node_sizes[len - 1 - *out_stop] + DLL_AFTER_NODE_LEN;
-        if (*out_count + backward_size > size.width) {
+        sizes[2 * window - 1 - stop] = list->parent.get_sizeof(backwards);
+        int backward_size = sizes[2 * window - 1 - stop] + after_node_len;
+        if (count + backward_size > size.width) {
             broke_due_to_size = true;
             break;
         }
 
-        *out_count += backward_size;
-        *out_backwards = (*out_backwards)->prev;
+        count += backward_size;
+        layout->back_start = (FakeNode)backwards;
+        layout->back_shown++;
+        backwards = backwards->prev;
     }
 
-    if (*out_stop == 0 && broke_due_to_size) {
-        printf("Error: No valid sizing constraint matches terminal size; i.e. "
-               "increase your terminal size since on current size can't even "
-               "fit the bare minimum\n");
-        exit(1);
+    if (stop == 0 && broke_due_to_size) {
+        exit_too_small_for_terminal();
     }
 
     if (!broke_due_to_size) {
-        // go through entire list
-        *out_forwards = NULL;
-        *out_backwards = NULL;
-        *out_count -= DLL_ELLIPSES_LEN;
+        // the two ends met in the middle
+        count -= ellipses_len;
+    } else {
+        layout->everything_fits = false;
     }
+    layout->count = count;
+    layout->front_sizes = sizes;
+    layout->back_sizes = sizes + 2 * window - layout->back_shown;
+}
 
-    return node_sizes;
+void dll_set_focus(DLL list, DLL_Node *focus) {
+    list->focus = focus;
+}
+
+static FakeNode dll_layout_prev(void *ctx, FakeNode n) {
+    return (FakeNode)((DLL_Node)n)->prev;
 }
 
 void dll_print_list(Collection list) {
     DLL dll = (DLL)list;
-    int len = dll_length(dll);
-    int count;
-    int stop;
-    DLL_Node forwards = dll->head;
-    DLL_Node backwards = dll->tail;
+    struct _list_layout_t layout;
+    LLVTheme theme = llv_theme();
     terminalSize size = get_terminal_size();
-    int *node_sizes = dll_attempt_fit(dll, len, size, &count, &forwards,
-                                      &backwards, &stop);
-    list_print_general(list, len, count, (FakeNode)forwards,
-                       (FakeNode)backwards, stop, node_sizes, DLL_AFTER_NODE,
-                       DLL_START_OF_LIST, DLL_END_OF_LIST, DLL_ELLIPSES,
+    if (dll->focus != NULL && *dll->focus != NULL) {
+        // we can walk backwards from the focus so there is nothing to find,
+        // anything that takes the focus out of the list stops us focusing on it
+        list_layout_around(list, (FakeNode)dll->head, (FakeNode)*dll->focus, dll_layout_prev,
+                           NULL, size.width, theme->dll_after_node, theme->dll_start_of_list,
+                           theme->dll_end_of_list, theme->dll_ellipses, &layout);
+    } else {
+        dll_layout(dll, size, theme, &layout);
+    }
+    list_print_general(list, llv_config(), theme, &layout, theme->dll_after_node,
+                       theme->dll_start_of_list, theme->dll_end_of_list, theme->dll_ellipses,
                        (FakeNode)dll->head, "Doubly Linked List");
 }
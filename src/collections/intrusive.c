@@ -0,0 +1,188 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include <wchar.h>
+
+#include "../../include/collections/intrusive.h"
+#include "../../include/collections/ll.h"
+#include "../../include/collections/dll.h"
+#include "../../include/helper.h"
+#include "../../include/llv.h"
+#include "../list_helper.h"
+
+void ll_print_list(Collection list);
+void dll_print_list(Collection list);
+void intrusive_print(Collection c);
+
+// the user's nodes we are going to show and the LLV nodes made from them,
+// both are reused every frame.
+static const void **intrusive_nodes = NULL;
+static struct _dll_node_t *intrusive_fake_nodes = NULL;
+static int intrusive_capacity = 0;
+
+IntrusiveList intrusive_new(char *name, void *head, IntrusiveDesc desc) {
+    LLVAllocator allocator = llv_allocator();
+    IntrusiveList list = (IntrusiveList)llv_alloc(allocator, sizeof(struct _intrusive_list_t),
+                                                  "Intrusive List");
+    list->parent.allocator = allocator;
+    list->parent.name = name;
+    list->parent.get_sizeof = list_sizeof;
+    list->parent.node_printer = list_print_node;
+    list->parent.list_printer = intrusive_print;
+    list->desc = desc;
+    list->head = head;
+    list->tail = NULL;
+    return list;
+}
+
+void intrusive_free(IntrusiveList list) {
+    llv_free(list->parent.allocator, list, sizeof(struct _intrusive_list_t));
+}
+
+void intrusive_set_tail(IntrusiveList list, void *tail) {
+    list->tail = tail;
+}
+
+static const void *intrusive_link(const void *node, size_t offset) {
+    return *(void *const*)((const char*)node + offset);
+}
+
+int intrusive_length(IntrusiveList list) {
+    int len = 0;
+    for (const void *n = *(void**)list->head; n != NULL;
+         n = intrusive_link(n, list->desc.next_offset)) {
+        len++;
+    }
+    return len;
+}
+
+static void intrusive_reserve(int n) {
+    if (n <= intrusive_capacity) return;
+    free(intrusive_nodes);
+    free(intrusive_fake_nodes);
+    intrusive_capacity = n < 64 ? 64 : n;
+    intrusive_nodes = (const void**)malloc_with_oom(sizeof(void*) * intrusive_capacity,
+                                                    "Intrusive Nodes");
+    intrusive_fake_nodes = (struct _dll_node_t*)malloc_with_oom(
+        sizeof(struct _dll_node_t) * intrusive_capacity, "Intrusive Nodes");
+}
+
+static void intrusive_fake_node(struct _dll_node_t *to, const void *from,
+                                const IntrusiveDesc *desc) {
+    if (from == NULL) {
+        // stands in for the middle of the list that is never shown
+        to->ptr = NULL;
+        to->data = data_int(0);
+        to->data_tag = INTEGER;
+        return;
+    }
+
+    const char *node = (const char*)from;
+    to->ptr = desc->label_offset != LLV_NO_OFFSET ? *(char**)(node + desc->label_offset) : NULL;
+    to->data_tag = desc->value_tag;
+    if (desc->value_read != NULL) {
+        to->data = desc->value_read(node + desc->value_offset, 0);
+    } else {
+        DataArray value = { node + desc->value_offset, desc->value_kind, desc->value_tag };
+        to->data = data_array_at(value, 0);
+    }
+}
+
+// fills intrusive_nodes with what the printers need to see returning how many
+// there are, for a long list that is the first and last `window` nodes with
+// a NULL between them for everything else (the printers never reach it).
+// If `back` is `back_index` nodes in (with at least `window` nodes from it to
+// the end) the end of a singly linked list is found from it not the head.
+static int intrusive_gather(const void *head, const void *tail, const void *back, int back_index,
+                            const IntrusiveDesc *desc, int window) {
+    int most = 2 * window + 1;
+    intrusive_reserve(most + window);
+    const void **nodes = intrusive_nodes;
+
+    int len = 0;
+    const void *n = head;
+    for (; n != NULL && len < most; n = intrusive_link(n, desc->next_offset)) {
+        nodes[len++] = n;
+    }
+    if (n == NULL) return len;
+
+    nodes[window] = NULL;
+    if (desc->prev_offset != LLV_NO_OFFSET && tail != NULL) {
+        const void *back = tail;
+        for (int i = most - 1; i > window; i--) {
+            nodes[i] = back;
+            back = intrusive_link(back, desc->prev_offset);
+        }
+        return most;
+    }
+
+    // walk the rest remembering the last `window` nodes, oldest at `end`
+    const void **ring = nodes + most;
+    memcpy(ring, nodes + window + 1, sizeof(void*) * window);
+    int end = 0;
+    if (back != NULL && back_index >= most) n = back;
+    for (; n != NULL; n = intrusive_link(n, desc->next_offset)) {
+        ring[end] = n;
+        end = (end + 1) % window;
+    }
+    for (int i = 0; i < window; i++) nodes[window + 1 + i] = ring[(end + i) % window];
+    return most;
+}
+
+static void intrusive_print_window(Collection c, const void *head, const void *tail,
+                                   const void *back, int back_index, const IntrusiveDesc *desc) {
+    bool doubly = desc->prev_offset != LLV_NO_OFFSET;
+    int window = intrusive_window(doubly);
+    int len = intrusive_gather(head, tail, back, back_index, desc, window);
+
+    struct _dll_node_t *fake = intrusive_fake_nodes;
+    for (int i = 0; i < len; i++) {
+        intrusive_fake_node(&fake[i], intrusive_nodes[i], desc);
+        fake[i].next = i + 1 < len ? &fake[i + 1] : NULL;
+        fake[i].prev = i > 0 ? &fake[i - 1] : NULL;
+    }
+
+    if (doubly) {
+        struct _doubly_linked_list_t list = {
+            .parent = *c,
+            .head = len > 0 ? fake : NULL,
+            .tail = len > 0 ? &fake[len - 1] : NULL,
+            .len = len,
+            .focus = NULL,
+        };
+        dll_print_list(&list.parent);
+    } else {
+        // a DLL node starts with everything an LL node has
+        struct _singly_linked_list_t list = {
+            .parent = *c,
+            .head = len > 0 ? (LL_Node)fake : NULL,
+            .tail = len > 0 ? (LL_Node)&fake[len - 1] : NULL,
+            .len = len,
+            .focus = NULL,
+            .anchor = NULL,
+        };
+        ll_print_list(&list.parent);
+    }
+}
+
+int intrusive_window(bool doubly) {
+    LLVTheme theme = llv_theme();
+    return list_max_visible(get_terminal_size().width,
+                            wcslen(doubly ? theme->dll_after_node : theme->ll_after_node));
+}
+
+void intrusive_print_nodes(Collection c, const void *head, const void *tail,
+                           const IntrusiveDesc *desc) {
+    intrusive_print_window(c, head, tail, NULL, 0, desc);
+}
+
+void intrusive_print_from(Collection c, const void *head, const void *back, int back_index,
+                          const IntrusiveDesc *desc) {
+    intrusive_print_window(c, head, NULL, back, back_index, desc);
+}
+
+void intrusive_print(Collection c) {
+    IntrusiveList list = (IntrusiveList)c;
+    const void *tail = list->tail != NULL ? *(void**)list->tail : NULL;
+    intrusive_print_nodes(c, *(void**)list->head, tail, &list->desc);
+}
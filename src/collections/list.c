@@ -6,6 +6,7 @@
 #include "../../include/helper.h"
 #include "../list_helper.h"
 #include "../array_helper.h"
+#include "../columns_helper.h"
 
 void list_print(Collection c);
 
@@ -16,9 +17,12 @@ int int_pow(int base, int exp) {
 }
 
 List list_new(char *name) {
-    List list = (List)malloc_with_oom(sizeof(struct _list_t), "List");
+    LLVAllocator allocator = llv_allocator();
+    List list = (List)llv_alloc(allocator, sizeof(struct _list_t), "List");
+    list->parent.allocator = allocator;
     list->cur_len = list->max_len = 0;
     list->data = NULL;
+    list->columns = NULL;
     list->grow_function = poly_grow_function;
     list->factor = 2.0;
     list->parent.get_sizeof = list_sizeof;
@@ -28,9 +32,16 @@ List list_new(char *name) {
     return list;
 }
 
+List list_new_soa(char *name, TypeTag tag) {
+    List list = list_new(name);
+    list->columns = columns_new(list->parent.allocator, tag);
+    return list;
+}
+
 void list_free(List list) {
-    if (list->data != NULL) free(list->data);
-    free(list);
+    if (list->columns != NULL) columns_free(list->columns, list->parent.allocator, list->max_len);
+    llv_free(list->parent.allocator, list->data, sizeof(struct _list_data_t) * list->max_len);
+    llv_free(list->parent.allocator, list, sizeof(struct _list_t));
 }
 
 int linear_grow_function(int old_len, int min_new_len, double factor) {
@@ -59,10 +70,43 @@ int exponential_grow_function(int old_len, int min_new_len, double factor) {
 }
 
 ListNode list_at(List list, int index) {
-    if (list->cur_len >= index) return NULL;
+    assert_msg(list->columns == NULL, "list:list_at can't be used on SoA lists "
+                                      "use list_get instead");
+    if (index >= list->cur_len) return NULL;
     return &list->data[index];
 }
 
+Data list_get(List list, int index) {
+    assert_msg(list->cur_len > index, "list:list_get %d is out of bounds, the max "
+                                      "index is %d\n", index, list->cur_len - 1);
+    if (list->columns != NULL) return columns_data(list->columns, index);
+    return list->data[index].data;
+}
+
+TypeTag list_get_tag(List list, int index) {
+    assert_msg(list->cur_len > index, "list:list_get_tag %d is out of bounds, the max "
+                                      "index is %d\n", index, list->cur_len - 1);
+    if (list->columns != NULL) return columns_tag(list->columns, index);
+    return list->data[index].data_tag;
+}
+
+char *list_get_ptr(List list, int index) {
+    assert_msg(list->cur_len > index, "list:list_get_ptr %d is out of bounds, the max "
+                                      "index is %d\n", index, list->cur_len - 1);
+    if (list->columns != NULL) return columns_label(list->columns, index);
+    return list->data[index].ptr;
+}
+
+void list_set_ptr(List list, int index, char *ptr) {
+    assert_msg(list->cur_len > index, "list:list_set_ptr %d is out of bounds, the max "
+                                      "index is %d\n", index, list->cur_len - 1);
+    if (list->columns != NULL) {
+        columns_set_label(list->columns, list->parent.allocator, index, ptr);
+    } else {
+        list->data[index].ptr = ptr;
+    }
+}
+
 struct _list_data_t list_new_node(Data data, TypeTag type) {
     return (struct _list_data_t) {
         .data = data,
@@ -73,15 +117,71 @@ struct _list_data_t list_new_node(Data data, TypeTag type) {
 
 void list_clear(List list, int release_memory) {
     list->cur_len = 0;
+    if (list->columns != NULL) {
+        list->columns->label_len = 0;
+        if (release_memory) {
+            columns_resize(list->columns, list->parent.allocator, list->max_len, 0);
+            list->max_len = 0;
+        }
+        return;
+    }
     if (release_memory) {
+        llv_free(list->parent.allocator, list->data, sizeof(struct _list_data_t) * list->max_len);
+        list->data = NULL;
         list->max_len = 0;
-        free(list->data);
     }
 }
 
+// writes `node` into the (empty) slot at `index`
+static void list_put(List list, int index, struct _list_data_t node) {
+    if (list->columns != NULL) {
+        columns_set(list->columns, list->parent.allocator, list->max_len, index,
+                    node.data, node.data_tag);
+        if (node.ptr != NULL) {
+            columns_set_label(list->columns, list->parent.allocator, index, node.ptr);
+        }
+    } else {
+        list->data[index] = node;
+    }
+}
+
+// makes room at `index` by moving everything from there back one
+static void list_open_gap(List list, int index) {
+    if (list->cur_len == list->max_len) list_reserve(list, list->cur_len + 1);
+    if (list->columns != NULL) {
+        columns_move(list->columns, index, index + 1, list->cur_len);
+    } else {
+        memmove(list->data + index + 1, list->data + index,
+            sizeof(struct _list_data_t) * (list->cur_len - index));
+    }
+    list->cur_len++;
+}
+
 void list_push_back(List list, struct _list_data_t node) {
     if (list->cur_len == list->max_len) list_reserve(list, list->cur_len + 1);
-    list->data[list->cur_len++] = node;
+    list_put(list, list->cur_len++, node);
+}
+
+List list_from_array(char *name, DataArray items, int n) {
+    List list = list_new(name);
+    list_append_n(list, items, n);
+    return list;
+}
+
+void list_append_n(List list, DataArray items, int n) {
+    if (n <= 0) return;
+    list_reserve(list, list->cur_len + n);
+    if (list->columns != NULL) {
+        for (int i = 0; i < n; i++) {
+            columns_set(list->columns, list->parent.allocator, list->max_len, list->cur_len + i,
+                        data_array_at(items, i), items.tag);
+        }
+        list->cur_len += n;
+        return;
+    }
+    ListNode nodes = list->data + list->cur_len;
+    for (int i = 0; i < n; i++) nodes[i] = list_new_node(data_array_at(items, i), items.tag);
+    list->cur_len += n;
 }
 
 /*
@@ -97,11 +197,8 @@ void list_insert_after(List list, int index, struct _list_data_t node) {
         return;
     }
 
-    if (list->cur_len == list->max_len) list_reserve(list, list->cur_len + 1);
-    memmove(list->data + index + 2, list->data + index + 1,
-        sizeof(struct _list_data_t) * (list->cur_len - 1 - index));
-    list->data[index + 1] = node;
-    list->cur_len++;
+    list_open_gap(list, index + 1);
+    list_put(list, index + 1, node);
 }
 
 void list_insert_before(List list, int index, struct _list_data_t node) {
@@ -113,17 +210,21 @@ void list_insert_before(List list, int index, struct _list_data_t node) {
         return;
     }
 
-    if (list->cur_len == list->max_len) list_reserve(list, list->cur_len + 1);
-    memmove(list->data + index + 1, list->data + index,
-        sizeof(struct _list_data_t) * (list->cur_len - 1 - index));
-    list->data[index] = node;
-    list->cur_len++;
+    list_open_gap(list, index);
+    list_put(list, index, node);
 }
 
 void list_remove(List list, int index) {
     assert_msg(list->cur_len > index, "list:list_insert_after %d is out of "
                                       "bounds, the max index"
                                       "is %d\n", index, list->cur_len - 1);
+    if (list->columns != NULL) {
+        columns_set_label(list->columns, list->parent.allocator, index, NULL);
+        columns_move(list->columns, index + 1, index, list->cur_len);
+        list->cur_len--;
+        return;
+    }
+
     // easy remove
     if (index == list->cur_len - 1) {
         list->cur_len--;
@@ -150,11 +251,19 @@ int list_capacity(List list) {
 void list_reserve(List list, int len) {
     if (list->max_len >= len) return;
     int new_len = list->grow_function(list->max_len, len, list->factor);
+    if (list->columns != NULL) {
+        columns_resize(list->columns, list->parent.allocator, list->max_len, new_len);
+        list->max_len = new_len;
+        return;
+    }
+    list->data = (ListNode)llv_realloc(list->parent.allocator, list->data,
+                                       sizeof(struct _list_data_t) * list->max_len,
+                                       sizeof(struct _list_data_t) * new_len, "List Nodes");
     list->max_len = new_len;
-    list->data = (ListNode)realloc(list->data, sizeof(struct _list_data_t) * list->max_len);
 }
 
 void list_print(Collection c) {
     List list = (List)c;
-    print_array_like(c, "List", (FakeArrayNode)list->data, list->cur_len);
+    ArrayView view = { .nodes = (FakeArrayNode)list->data, .columns = list->columns };
+    print_array_like(c, llv_config(), llv_theme(), "List", view, list->cur_len);
 }
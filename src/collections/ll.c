@@ -7,10 +7,10 @@
 
 #include "../../include/collections/ll.h"
 #include "../../include/helper.h"
+#include "../../include/llv.h"
 #include "../list_helper.h"
-
-#define LL_AFTER_NODE (select_str_unicode(L" ➢ ", L" -> "))
-#define LL_AFTER_NODE_LEN (wcslen(LL_AFTER_NODE))
+#include "../general_collection_helper.h"
+#include "../node_pool.h"
 
 // This used to be `NULL_NODE " <- "` but I've made it empty (but still a definition)
 // Since I felt that wasn't really what a linked list should look like as there is no
@@ -18,17 +18,21 @@
 // just incase it turns out we want this to look like it used to or some other way.
 #define LL_START_OF_LIST (L"")
 #define LL_START_OF_LIST_LEN (wcslen(LL_START_OF_LIST))
-#define LL_END_OF_LIST (select_str_unicode(L" ➢ " NULL_NODE, L" -> " NULL_NODE))
-#define LL_END_OF_LIST_LEN (wcslen(LL_END_OF_LIST))
-#define LL_ELLIPSES (select_str_unicode(L"... ➢ ", L"... -> "))
-#define LL_ELLIPSES_LEN (wcslen(LL_ELLIPSES))
+
+// every LL node comes from here, see ll_clear
+static struct _node_pool_t ll_node_pool = NODE_POOL_INIT(struct _LL_node_t, "LL LL_Node");
 
 void ll_print_list(Collection list);
 
 LL ll_new(char *name) {
-    LL ll = (LL)malloc_with_oom(sizeof(struct _singly_linked_list_t), "LL");
+    LLVAllocator allocator = llv_allocator();
+    LL ll = (LL)llv_alloc(allocator, sizeof(struct _singly_linked_list_t), "LL");
+    ll->parent.allocator = allocator;
     ll->parent.name = name;
     ll->head = ll->tail = NULL;
+    ll->len = 0;
+    ll->focus = NULL;
+    ll->anchor = NULL;
     ll->parent.list_printer = ll_print_list;
     ll->parent.get_sizeof = list_sizeof;
     ll->parent.node_printer = list_print_node;
@@ -37,17 +41,17 @@ LL ll_new(char *name) {
 
 void ll_free(LL list) {
     ll_clear(list);
-    free(list);
+    llv_free(list->parent.allocator, list, sizeof(struct _singly_linked_list_t));
 }
 
 void ll_free_node(LL_Node n) {
     // should help catch any dereferencing memory that can't be accessed.
     n->next = NULL;
-    free(n);
+    node_pool_free(&ll_node_pool, n);
 }
 
 LL_Node ll_new_node(Data data, TypeTag type) {
-    LL_Node new_node = (LL_Node)malloc_with_oom(sizeof(struct _LL_node_t), "LL LL_Node");
+    LL_Node new_node = (LL_Node)node_pool_alloc(&ll_node_pool);
     new_node->next = NULL;
     new_node->data = data;
     new_node->data_tag = type;
@@ -67,20 +71,125 @@ void ll_append(LL list, LL_Node n) {
     ll_insert_after(list, n, list->tail);
 }
 
+// `n` nodes in one block linked in order, the first holding `items[first]`
+// and each after it the item `step` along.
+static LL_Node ll_new_nodes(DataArray items, int n, int first, int step) {
+    LL_Node nodes = (LL_Node)node_pool_alloc_n(&ll_node_pool, n);
+    for (int i = 0; i < n; i++) {
+        nodes[i].next = &nodes[i + 1];
+        nodes[i].data = data_array_at(items, first + i * step);
+        nodes[i].data_tag = items.tag;
+        nodes[i].ptr = NULL;
+    }
+    nodes[n - 1].next = NULL;
+    return nodes;
+}
+
+LL ll_from_array(char *name, DataArray items, int n) {
+    LL list = ll_new(name);
+    ll_append_n(list, items, n);
+    return list;
+}
+
+void ll_append_n(LL list, DataArray items, int n) {
+    if (n <= 0) return;
+    LL_Node nodes = ll_new_nodes(items, n, 0, 1);
+    if (list->tail == NULL) list->head = nodes;
+    else list->tail->next = nodes;
+    list->tail = &nodes[n - 1];
+    list->len += n;
+}
+
+void ll_push_n(LL list, DataArray items, int n) {
+    if (n <= 0) return;
+    // the last item pushed ends up at the head
+    LL_Node nodes = ll_new_nodes(items, n, n - 1, -1);
+    nodes[n - 1].next = list->head;
+    if (list->tail == NULL) list->tail = &nodes[n - 1];
+    list->head = nodes;
+    list->len += n;
+}
+
+static void ll_sort_pass(void *ctx, FakeNode head, FakeNode tail) {
+    LL list = (LL)ctx;
+    list->head = (LL_Node)head;
+    list->tail = (LL_Node)tail;
+    update(1, list);
+}
+
+void ll_sort(LL list, fn_data_compare cmp) {
+    ll_sort_animated(list, cmp, 0);
+}
+
+void ll_sort_animated(LL list, fn_data_compare cmp, int passes_per_frame) {
+    FakeNode tail;
+    list->anchor = NULL;
+    list->head = (LL_Node)list_merge_sort((FakeNode)list->head, cmp, &tail, passes_per_frame,
+                                          passes_per_frame > 0 ? ll_sort_pass : NULL, list);
+    list->tail = (LL_Node)tail;
+}
+
+void ll_concat(LL list, LL other) {
+    ll_splice(list, list->tail, other);
+}
+
+void ll_splice(LL list, LL_Node at, LL other) {
+    if (other->head == NULL) return;
+    if (at == NULL) {
+        other->tail->next = list->head;
+        list->head = other->head;
+    } else {
+        other->tail->next = at->next;
+        at->next = other->head;
+    }
+    if (other->tail->next == NULL) list->tail = other->tail;
+    list->len += other->len;
+
+    other->head = other->tail = NULL;
+    other->len = 0;
+    other->anchor = NULL;
+}
+
+LL ll_split_at(LL list, int index, char *name) {
+    LL rest = ll_new(name);
+    if (index >= list->len) return rest;
+    if (index < 0) index = 0;
+
+    LL_Node before = NULL;
+    for (int i = 0; i < index; i++) before = before == NULL ? list->head : before->next;
+
+    rest->head = before == NULL ? list->head : before->next;
+    rest->tail = list->tail;
+    rest->len = list->len - index;
+    if (before == NULL) list->head = NULL;
+    else before->next = NULL;
+    list->tail = before;
+    list->len = index;
+    list->anchor = NULL;
+    return rest;
+}
+
 void ll_clear(LL list) {
     for (LL_Node cur = list->head; cur != NULL;) {
         LL_Node temp = cur;
         cur = cur->next;
-        free(temp);
+        node_pool_free(&ll_node_pool, temp);
     }
+    // only once every node has been given back (by any list or by hand)
+    // can the slabs go, the list's len can't tell us that.
+    if (ll_node_pool.live == 0) node_pool_release(&ll_node_pool);
     list->head = list->tail = NULL;
+    list->len = 0;
+    list->anchor = NULL;
 }
 
 void ll_insert_after(LL list, LL_Node node, LL_Node at) {
     node->next = NULL;
     if (at == NULL) {
         list->tail = list->head = node;
+        list->len = 1;
     } else {
+        list->len++;
         LL_Node post_at = at->next;
         // at -> post_at => at -> node -> post_at;
         node->next = post_at;
@@ -93,7 +202,9 @@ void ll_insert_before(LL list, LL_Node node, LL_Node at) {
     node->next = NULL;
     if (at == NULL) {
         list->tail = list->head = node;
+        list->len = 1;
     } else {
+        list->len++;
         LL_Node at_prev = NULL;
         if (at == list->head) {
             list->head = node;
@@ -121,10 +232,54 @@ LL_Node ll_remove_node(LL list, LL_Node node) {
     if (node == list->tail) {
         list->tail = at_prev;
     }
+    if (node == list->anchor) list->anchor = NULL;
     node->next = NULL;
+    list->len--;
     return node;
 }
 
+LL_Node ll_remove_after(LL list, LL_Node at) {
+    LL_Node node = at == NULL ? list->head : at->next;
+    if (node == NULL) return NULL;
+
+    if (at == NULL) list->head = node->next;
+    else            at->next = node->next;
+    if (node == list->tail) list->tail = at;
+    if (node == list->anchor) list->anchor = NULL;
+    node->next = NULL;
+    list->len--;
+    return node;
+}
+
+LL_Cursor ll_cursor(LL list) {
+    LL_Cursor cursor = { .list = list, .prev = NULL, .cur = list->head };
+    return cursor;
+}
+
+void ll_cursor_next(LL_Cursor *cursor) {
+    if (cursor->cur == NULL) return;
+    cursor->prev = cursor->cur;
+    cursor->cur = cursor->cur->next;
+}
+
+LL_Node ll_cursor_remove(LL_Cursor *cursor) {
+    if (cursor->cur == NULL) return NULL;
+    LL_Node node = cursor->cur;
+    cursor->cur = node->next;
+    return ll_remove_after(cursor->list, cursor->prev);
+}
+
+void ll_cursor_insert_before(LL_Cursor *cursor, LL_Node node) {
+    LL list = cursor->list;
+    // prev -> cur => prev -> node -> cur
+    node->next = cursor->cur;
+    if (cursor->prev == NULL) list->head = node;
+    else                      cursor->prev->next = node;
+    if (cursor->cur == NULL) list->tail = node;
+    list->len++;
+    cursor->prev = node;
+}
+
 bool ll_is_empty(LL list) {
     return list->head == NULL;
 }
@@ -145,93 +300,183 @@ LL_Node ll_find_next(LL_Node n) {
     return n->next;
 }
 
-int *ll_attempt_fit(LL list, int len, terminalSize size, int *out_count,
-                    LL_Node *out_forwards, LL_Node *out_backwards, int *out_stop) {
-    int *node_sizes = (int*)malloc_with_oom(sizeof(int) * len, "node_sizes");
+// the size of node `index` out of the window ll_layout fills in,
+// the first `front_len` nodes are followed by everything from `back_from`.
+static int ll_window_size(int *sizes, int index, int front_len, int back_from) {
+    return index < front_len ? sizes[index] : sizes[front_len + index - back_from];
+}
+
+void ll_layout(LL list, terminalSize size, LLVTheme theme, ListLayout layout) {
+    int len = list->len;
+    layout->everything_fits = true;
+    layout->hidden_before = layout->hidden_after = false;
+    layout->front_start = (FakeNode)list->head;
+    layout->front_shown = layout->back_shown = 0;
+    layout->front_sizes = layout->back_sizes = NULL;
+    layout->back_start = NULL;
 
     if (ll_is_empty(list)) {
-        *out_stop = 0;
-        *out_count = NULL_NODE_LEN;
-        return node_sizes;
+        layout->count = NULL_NODE_LEN;
+        return;
     }
 
-    *out_count = LL_START_OF_LIST_LEN + NULL_NODE_LEN;
-    *out_stop = 0;
-    for (; *out_forwards != NULL; *out_forwards = (*out_forwards)->next, (*out_stop)++) {
-        node_sizes[*out_stop] = list->parent.get_sizeof(*out_forwards);
-        *out_count += node_sizes[*out_stop] + LL_AFTER_NODE_LEN;
+    int after_node_len = wcslen(theme->ll_after_node);
+    // we can never show more than `window` nodes from either end, so we only
+    // size the first and last `window` nodes and skip over the rest.
+    int window = list_max_visible(size.width, after_node_len);
+    int front_len = len < window ? len : window;
+    int back_len = len - front_len < window ? len - front_len : window;
+    int back_from = len - back_len;
+    int *sizes = list_layout_sizes(front_len + back_len);
+
+    LL_Node window_start = list->head;
+    int count = LL_START_OF_LIST_LEN + NULL_NODE_LEN;
+    int i = 0;
+    for (LL_Node n = list->head; n != NULL; n = n->next, i++) {
+        if (i < front_len) {
+            sizes[i] = list->parent.get_sizeof(n);
+            count += sizes[i] + after_node_len;
+        } else if (i >= back_from) {
+            if (i == back_from) window_start = n;
+            sizes[front_len + i - back_from] = list->parent.get_sizeof(n);
+        }
     }
 
-    // if we fit on screen then exit, we won't use out_backwards!
-    if (*out_count <= size.width) {
-        return node_sizes;
+    // anything longer than the window can't fit (so we never needed its total)
+    layout->front_sizes = sizes;
+    if (back_len == 0 && count <= size.width) {
+        layout->count = count;
+        layout->front_shown = len;
+        return;
     }
 
-    *out_count = NULL_NODE_LEN + LL_ELLIPSES_LEN + LL_START_OF_LIST_LEN;
-    *out_stop = 0;
-    *out_forwards = list->head;
-
-    // how far backwards we can go
-    int backwards_index = 0;
+    layout->everything_fits = false;
+    count = NULL_NODE_LEN + wcslen(theme->ll_ellipses) + LL_START_OF_LIST_LEN;
+    int stop = 0;
     bool broke_due_to_size = false;
     // Account for odd lists by including the extra element on the left side
-    for (; *out_stop < (len + 1) / 2; (*out_stop)++) {
-        int forward_size = node_sizes[*out_stop] + LL_AFTER_NODE_LEN;
-        if (forward_size + *out_count > size.width) {
+    for (; stop < (len + 1) / 2; stop++) {
+        int forward_size = ll_window_size(sizes, stop, front_len, back_from) + after_node_len;
+        if (forward_size + count > size.width) {
             broke_due_to_size = true;
             break;
         }
-        *out_forwards = (*out_forwards)->next;
-        *out_count += forward_size;
+        layout->front_shown++;
+        count += forward_size;
 
-        if (*out_stop == len / 2) break;
+        if (stop == len / 2) break;
 
-        int backward_size = node_sizes[len - 1 - *out_stop] + LL_AFTER_NODE_LEN;
-        if (backward_size + *out_count > size.width) {
+        int backward_size = ll_window_size(sizes, len - 1 - stop, front_len, back_from) +
+                            after_node_len;
+        if (backward_size + count > size.width) {
             broke_due_to_size = true;
             break;
         }
-        *out_count += backward_size;
-        backwards_index++;
+        count += backward_size;
+        layout->back_shown++;
     }
 
-    if (*out_stop == 0 && broke_due_to_size) {
-        printf("Error: No valid sizing constraint matches terminal size; i.e. increase your terminal size since on current size can't even fit the bare minimum\n");
-        exit(1);
+    if (stop == 0 && broke_due_to_size) {
+        exit_too_small_for_terminal();
     }
+    layout->count = count;
+    if (layout->back_shown == 0) return;
+
+    // the back nodes are within the window so this is a short walk
+    int back_index = len - layout->back_shown;
+    LL_Node back = back_index >= back_from ? window_start : list->head;
+    for (i = back_index >= back_from ? back_from : 0; i < back_index; i++) back = back->next;
+    layout->back_start = (FakeNode)back;
+    layout->back_sizes = back_index < front_len ? sizes + back_index
+                                                : sizes + front_len + back_index - back_from;
+}
 
-    // we need to actually traverse the list
-    // find middle
-    LL_Node middle = list->head;
-    for (int i = 0; i < len / 2; i++) middle = middle->next;
-    *out_backwards = middle;
+int ll_length(LL list) {
+    return list->len;
+}
 
-    // now go forwards from backwards (len / 2) - backwards_index times
-    for (int i = len / 2; i < len - 1 - backwards_index; i++) {
-        *out_backwards = (*out_backwards)->next;
-    }
+void ll_set_focus(LL list, LL_Node *focus) {
+    list->focus = focus;
+    list->anchor = NULL;
+}
 
-    return node_sizes;
+// the last `window` nodes walked before the focus, oldest first
+typedef struct _ll_trail_t {
+    FakeNode *nodes;
+    int window;
+    int len;
+    int end;
+    FakeNode last;  // the focus or the node we handed back last
+} *LLTrail;
+
+// hands back the trail newest first (i.e. walking backwards from the focus),
+// we can't go back from just any node so `n` has to be the last one we gave.
+static FakeNode ll_trail_prev(void *ctx, FakeNode n) {
+    LLTrail trail = (LLTrail)ctx;
+    assert_msg(n == trail->last, "ll:ll_trail_prev, the trail has to be walked one "
+                                 "node at a time back from the focus\n");
+    if (trail->len == 0) return NULL;
+    trail->len--;
+    trail->end = (trail->end + trail->window - 1) % trail->window;
+    trail->last = trail->nodes[trail->end];
+    return trail->last;
 }
 
-int ll_length(LL list) {
-    int count = 0;
-    for (LL_Node n = list->head; n != NULL; n = n->next) count++;
-    return count;
+// walks from `from` to the focus remembering the nodes just before it,
+// the anchor is left a couple of windows back so small steps either way
+// by the focus next frame don't need a walk from the head.
+static bool ll_walk_to_focus(LL list, LL_Node from, LL_Node focus, LLTrail trail) {
+    trail->len = trail->end = 0;
+    LL_Node anchor = from;
+    int steps = 0;
+    for (LL_Node n = from; n != NULL; n = n->next, steps++) {
+        if (n == focus) {
+            list->anchor = anchor;
+            trail->last = (FakeNode)focus;
+            return true;
+        }
+        trail->nodes[trail->end] = (FakeNode)n;
+        trail->end = (trail->end + 1) % trail->window;
+        if (trail->len < trail->window) trail->len++;
+        if (steps >= 2 * trail->window) anchor = anchor->next;
+    }
+    return false;
+}
+
+static bool ll_layout_focus(LL list, terminalSize size, LLVTheme theme, ListLayout layout) {
+    LL_Node focus = *list->focus;
+    if (focus == NULL) return false;
+
+    struct _ll_trail_t trail;
+    trail.window = list_max_visible(size.width, wcslen(theme->ll_after_node));
+    trail.nodes = list_layout_nodes(trail.window);
+
+    LL_Node from = list->anchor != NULL ? list->anchor : list->head;
+    bool found = ll_walk_to_focus(list, from, focus, &trail);
+    // either it went backwards or we don't have enough before it to fill the screen
+    if (from != list->head && (!found || trail.len < trail.window)) {
+        found = ll_walk_to_focus(list, list->head, focus, &trail);
+    }
+    if (!found) {
+        list->anchor = NULL;
+        return false;
+    }
+
+    list_layout_around((Collection)list, (FakeNode)list->head, (FakeNode)focus, ll_trail_prev,
+                       &trail, size.width, theme->ll_after_node, LL_START_OF_LIST,
+                       theme->ll_end_of_list, theme->ll_ellipses, layout);
+    return true;
 }
 
 void ll_print_list(Collection list) {
     LL ll = (LL)list;
-    int len = ll_length(ll);
-    int count;
-    int stop;
-    LL_Node forwards = ll->head;
-    LL_Node backwards = ll->tail;
+    struct _list_layout_t layout;
+    LLVTheme theme = llv_theme();
     terminalSize size = get_terminal_size();
-    int *node_sizes = ll_attempt_fit(ll, len, size, &count, &forwards,
-                                     &backwards, &stop);
-    list_print_general(list, len, count, (FakeNode)forwards,
-                       (FakeNode)backwards, stop, node_sizes, LL_AFTER_NODE,
-                       LL_START_OF_LIST, LL_END_OF_LIST, LL_ELLIPSES,
+    if (ll->focus == NULL || !ll_layout_focus(ll, size, theme, &layout)) {
+        ll_layout(ll, size, theme, &layout);
+    }
+    list_print_general(list, llv_config(), theme, &layout, theme->ll_after_node,
+                       LL_START_OF_LIST, theme->ll_end_of_list, theme->ll_ellipses,
                        (FakeNode)ll->head, "Linked List");
 }
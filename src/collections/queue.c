@@ -41,6 +41,14 @@ void queue_enqueue(Queue queue, QueueNode node) {
     ll_append(queue, node);
 }
 
+Queue queue_from_array(char *name, DataArray items, int n) {
+    return ll_from_array(name, items, n);
+}
+
+void queue_enqueue_n(Queue queue, DataArray items, int n) {
+    ll_append_n(queue, items, n);
+}
+
 QueueNode queue_dequeue(Queue queue) {
     return ll_pop(queue);
 }
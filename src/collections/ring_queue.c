@@ -0,0 +1,123 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "../../include/collections/ring_queue.h"
+#include "../../include/helper.h"
+#include "../list_helper.h"
+#include "../array_helper.h"
+
+#define RING_QUEUE_MIN_CAPACITY (8)
+
+void ring_queue_print(Collection c);
+
+// capacity is a power of 2 so wrapping around is a mask
+static int ring_queue_slot(RingQueue queue, int index) {
+    return (queue->head + index) & (queue->capacity - 1);
+}
+
+RingQueue ring_queue_new(char *name) {
+    LLVAllocator allocator = llv_allocator();
+    RingQueue queue = (RingQueue)llv_alloc(allocator, sizeof(struct _ring_queue_t), "Ring Queue");
+    queue->parent.allocator = allocator;
+    queue->parent.name = name;
+    queue->parent.get_sizeof = list_sizeof;
+    queue->parent.node_printer = list_print_node;
+    queue->parent.list_printer = ring_queue_print;
+    queue->data = NULL;
+    queue->head = queue->len = queue->capacity = 0;
+    return queue;
+}
+
+void ring_queue_free(RingQueue queue) {
+    llv_free(queue->parent.allocator, queue->data,
+             sizeof(struct _ring_queue_data_t) * queue->capacity);
+    llv_free(queue->parent.allocator, queue, sizeof(struct _ring_queue_t));
+}
+
+int ring_queue_length(RingQueue queue) {
+    return queue->len;
+}
+
+bool ring_queue_is_empty(RingQueue queue) {
+    return queue->len == 0;
+}
+
+void ring_queue_clear(RingQueue queue) {
+    queue->head = queue->len = 0;
+}
+
+void ring_queue_reserve(RingQueue queue, int len) {
+    if (len <= queue->capacity) return;
+    int old_capacity = queue->capacity;
+    int new_capacity = old_capacity == 0 ? RING_QUEUE_MIN_CAPACITY : old_capacity;
+    while (new_capacity < len) new_capacity *= 2;
+
+    queue->data = (RingQueueNode)llv_realloc(queue->parent.allocator, queue->data,
+                                             sizeof(struct _ring_queue_data_t) * old_capacity,
+                                             sizeof(struct _ring_queue_data_t) * new_capacity,
+                                             "Ring Queue Nodes");
+    queue->capacity = new_capacity;
+    // the items that wrapped around to the start go after the rest
+    int wrapped = queue->head + queue->len - old_capacity;
+    if (wrapped > 0) {
+        memcpy(queue->data + old_capacity, queue->data,
+               sizeof(struct _ring_queue_data_t) * wrapped);
+    }
+}
+
+struct _ring_queue_data_t ring_queue_new_node(Data data, TypeTag type) {
+    return (struct _ring_queue_data_t) {
+        .data = data,
+        .data_tag = type,
+        .ptr = NULL,
+    };
+}
+
+void ring_queue_enqueue(RingQueue queue, struct _ring_queue_data_t node) {
+    if (queue->len == queue->capacity) ring_queue_reserve(queue, queue->len + 1);
+    queue->data[ring_queue_slot(queue, queue->len)] = node;
+    queue->len++;
+}
+
+RingQueue ring_queue_from_array(char *name, DataArray items, int n) {
+    RingQueue queue = ring_queue_new(name);
+    ring_queue_enqueue_n(queue, items, n);
+    return queue;
+}
+
+void ring_queue_enqueue_n(RingQueue queue, DataArray items, int n) {
+    if (n <= 0) return;
+    ring_queue_reserve(queue, queue->len + n);
+    for (int i = 0; i < n; i++) {
+        queue->data[ring_queue_slot(queue, queue->len + i)] =
+            ring_queue_new_node(data_array_at(items, i), items.tag);
+    }
+    queue->len += n;
+}
+
+struct _ring_queue_data_t ring_queue_dequeue(RingQueue queue) {
+    assert_msg(queue->len > 0, "ring_queue:ring_queue_dequeue, the queue is empty\n");
+    struct _ring_queue_data_t node = queue->data[queue->head];
+    queue->head = ring_queue_slot(queue, 1);
+    queue->len--;
+    return node;
+}
+
+RingQueueNode ring_queue_at(RingQueue queue, int index) {
+    if (index < 0 || index >= queue->len) return NULL;
+    return &queue->data[ring_queue_slot(queue, index)];
+}
+
+RingQueueNode ring_queue_front(RingQueue queue) {
+    return ring_queue_at(queue, 0);
+}
+
+void ring_queue_print(Collection c) {
+    RingQueue queue = (RingQueue)c;
+    char title[64];
+    snprintf(title, sizeof(title), "Ring Queue (head %d, tail %d)", queue->head,
+             queue->capacity == 0 ? 0 : ring_queue_slot(queue, queue->len));
+    ArrayView view = { .nodes = (FakeArrayNode)queue->data, .start = queue->head,
+                       .wrap = queue->capacity };
+    print_array_like(c, llv_config(), llv_theme(), title, view, queue->len);
+}
@@ -41,6 +41,16 @@ void stack_push(Stack stack, StackNode node) {
     ll_push(stack, node);
 }
 
+Stack stack_from_array(char *name, DataArray items, int n) {
+    Stack stack = ll_new(name);
+    ll_push_n(stack, items, n);
+    return stack;
+}
+
+void stack_push_n(Stack stack, DataArray items, int n) {
+    ll_push_n(stack, items, n);
+}
+
 StackNode stack_pop(Stack stack) {
     return ll_pop(stack);
 }
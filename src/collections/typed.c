@@ -0,0 +1,68 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "../../include/collections/typed.h"
+#include "../../include/collections/intrusive.h"
+#include "../../include/helper.h"
+#include "../../include/llv.h"
+#include "../list_helper.h"
+#include "../array_helper.h"
+
+void llv_typed_init(Collection c, char *name, fn_print_list printer, LLVAllocator allocator) {
+    c->name = name;
+    c->allocator = allocator;
+    c->list_printer = printer;
+    // the printers only ever see nodes they made so these are the normal ones
+    c->get_sizeof = list_sizeof;
+    c->node_printer = list_print_node;
+}
+
+void llv_typed_print_array(Collection c, char *collection_type, const void *items, int len,
+                           fn_typed_read read, TypeTag tag) {
+    ArrayView view = { .nodes = NULL, .columns = NULL, .items = items, .read = read, .tag = tag };
+    print_array_like(c, llv_config(), llv_theme(), collection_type, view, len);
+}
+
+static void *llv_typed_next(const void *node, size_t next_offset) {
+    return *(void**)((const char*)node + next_offset);
+}
+
+void llv_typed_back_append(LLVTypedBack *back, size_t next_offset) {
+    if (back->node == NULL) return;
+    if (++back->after > back->wanted) {
+        back->node = llv_typed_next(back->node, next_offset);
+        back->after--;
+    }
+}
+
+void llv_typed_print_ll(Collection c, const void *head, int len, LLVTypedBack *back,
+                        size_t ptr_offset, size_t next_offset, fn_typed_read read, TypeTag tag) {
+    // we need the last `window` nodes, so the back node goes `window - 1` from the tail.
+    // Finding it from the head is only needed the first time (or once the
+    // terminal grows) after that append/pop keep it there.
+    int window = intrusive_window(false);
+    back->wanted = window - 1;
+    if (len < window) {
+        back->node = NULL;
+    } else if (back->node == NULL || back->after < back->wanted) {
+        back->node = (void*)head;
+        for (int i = 0; i < len - window; i++) back->node = llv_typed_next(back->node, next_offset);
+        back->after = back->wanted;
+    } else {
+        for (; back->after > back->wanted; back->after--) {
+            back->node = llv_typed_next(back->node, next_offset);
+        }
+    }
+
+    IntrusiveDesc desc = {
+        .next_offset = next_offset,
+        .prev_offset = LLV_NO_OFFSET,
+        .value_offset = 0,
+        .value_kind = DATA_ARRAY_DATA,
+        .value_tag = tag,
+        .label_offset = ptr_offset,
+        .value_read = read,
+    };
+    intrusive_print_from(c, head, back->node, len - 1 - back->after, &desc);
+}
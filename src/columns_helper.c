@@ -0,0 +1,112 @@
+#include "columns_helper.h"
+
+#include <string.h>
+#include <stdbool.h>
+
+#define COLUMNS_MIN_LABELS (4)
+
+DataColumns columns_new(LLVAllocator allocator, TypeTag tag) {
+    DataColumns columns = (DataColumns)llv_alloc(allocator, sizeof(struct _data_columns_t),
+                                                 "Columns");
+    columns->data = NULL;
+    columns->tags = NULL;
+    columns->tag = tag;
+    columns->labels = NULL;
+    columns->label_len = columns->label_capacity = 0;
+    return columns;
+}
+
+void columns_free(DataColumns columns, LLVAllocator allocator, int capacity) {
+    llv_free(allocator, columns->data, sizeof(Data) * capacity);
+    llv_free(allocator, columns->tags, capacity);
+    llv_free(allocator, columns->labels, sizeof(struct _data_label_t) * columns->label_capacity);
+    llv_free(allocator, columns, sizeof(struct _data_columns_t));
+}
+
+void columns_resize(DataColumns columns, LLVAllocator allocator, int old_capacity,
+                    int new_capacity) {
+    columns->data = (Data*)llv_realloc(allocator, columns->data, sizeof(Data) * old_capacity,
+                                       sizeof(Data) * new_capacity, "Data Column");
+    if (columns->tags != NULL) {
+        columns->tags = (unsigned char*)llv_realloc(allocator, columns->tags, old_capacity,
+                                                    new_capacity, "Tag Column");
+    }
+
+    // shrinking drops the labels of anything that no longer fits
+    while (columns->label_len > 0 &&
+           columns->labels[columns->label_len - 1].index >= new_capacity) {
+        columns->label_len--;
+    }
+}
+
+Data columns_data(DataColumns columns, int index) {
+    return columns->data[index];
+}
+
+TypeTag columns_tag(DataColumns columns, int index) {
+    return columns->tags != NULL ? (TypeTag)columns->tags[index] : columns->tag;
+}
+
+// the first label at or after `index`
+static int columns_find_label(DataColumns columns, int index) {
+    int low = 0;
+    int high = columns->label_len;
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        if (columns->labels[mid].index < index) low = mid + 1;
+        else high = mid;
+    }
+    return low;
+}
+
+char *columns_label(DataColumns columns, int index) {
+    if (columns->label_len == 0) return NULL;
+    int i = columns_find_label(columns, index);
+    if (i == columns->label_len || columns->labels[i].index != index) return NULL;
+    return columns->labels[i].ptr;
+}
+
+void columns_set(DataColumns columns, LLVAllocator allocator, int capacity, int index,
+                 Data data, TypeTag tag) {
+    if (columns->tags == NULL && tag != columns->tag) {
+        columns->tags = (unsigned char*)llv_alloc(allocator, capacity, "Tag Column");
+        memset(columns->tags, columns->tag, capacity);
+    }
+    columns->data[index] = data;
+    if (columns->tags != NULL) columns->tags[index] = tag;
+}
+
+void columns_set_label(DataColumns columns, LLVAllocator allocator, int index, char *ptr) {
+    int i = columns_find_label(columns, index);
+    bool found = i < columns->label_len && columns->labels[i].index == index;
+    if (found && ptr != NULL) {
+        columns->labels[i].ptr = ptr;
+    } else if (found) {
+        memmove(columns->labels + i, columns->labels + i + 1,
+                sizeof(struct _data_label_t) * (columns->label_len - i - 1));
+        columns->label_len--;
+    } else if (ptr != NULL) {
+        if (columns->label_len == columns->label_capacity) {
+            int new_capacity = columns->label_capacity == 0 ? COLUMNS_MIN_LABELS
+                                                            : columns->label_capacity * 2;
+            columns->labels = (struct _data_label_t*)llv_realloc(
+                allocator, columns->labels,
+                sizeof(struct _data_label_t) * columns->label_capacity,
+                sizeof(struct _data_label_t) * new_capacity, "Labels");
+            columns->label_capacity = new_capacity;
+        }
+        memmove(columns->labels + i + 1, columns->labels + i,
+                sizeof(struct _data_label_t) * (columns->label_len - i));
+        columns->labels[i] = (struct _data_label_t){.index = index, .ptr = ptr};
+        columns->label_len++;
+    }
+}
+
+void columns_move(DataColumns columns, int from, int to, int len) {
+    if (from >= len || from == to) return;
+    memmove(columns->data + to, columns->data + from, sizeof(Data) * (len - from));
+    if (columns->tags != NULL) memmove(columns->tags + to, columns->tags + from, len - from);
+    for (int i = columns_find_label(columns, from); i < columns->label_len; i++) {
+        columns->labels[i].index += to - from;
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef LLV_COLUMNS_HELPER
+#define LLV_COLUMNS_HELPER
+
+#include "../include/types/columns.h"
+#include "../include/types/allocator.h"
+
+/*
+    The bookkeeping behind SoA Arrays and Lists, `capacity` is always how many
+    elements the columns have room for (the collection tracks it).
+*/
+
+DataColumns columns_new(LLVAllocator allocator, TypeTag tag);
+
+void columns_free(DataColumns columns, LLVAllocator allocator, int capacity);
+
+/*
+    Grows (or shrinks) the columns keeping the first `min(old, new)` elements.
+*/
+void columns_resize(DataColumns columns, LLVAllocator allocator, int old_capacity,
+                    int new_capacity);
+
+Data columns_data(DataColumns columns, int index);
+
+TypeTag columns_tag(DataColumns columns, int index);
+
+/*
+    The label at `index` or NULL if there isn't one.
+*/
+char *columns_label(DataColumns columns, int index);
+
+/*
+    Sets the element at `index`, the first element that isn't a `columns->tag`
+    brings the tag column into existence.
+*/
+void columns_set(DataColumns columns, LLVAllocator allocator, int capacity, int index,
+                 Data data, TypeTag tag);
+
+/*
+    Labels `index` with `ptr` (NULL removes the label).
+*/
+void columns_set_label(DataColumns columns, LLVAllocator allocator, int index, char *ptr);
+
+/*
+    Moves the elements [from, len) so they start at `to`, their labels go with them.
+    Any label at a position that is overwritten must already be removed.
+*/
+void columns_move(DataColumns columns, int from, int to, int len);
+
+#endif /* LLV_COLUMNS_HELPER */
@@ -1,16 +1,29 @@
 #include "env_var.h"
 
+static struct _llv_config_t config_snapshot;
+static bool config_loaded = false;
+
+void llv_config_reload(void) {
+    char *str;
+#undef new_env_var
+#define new_env_var(field, name, env_name, type, default_value, process_fn) \
+    str = getenv(#env_name); \
+    config_snapshot.field = str != NULL ? process_fn(str) : default_value;
+
+#include "env_var.incl"
+    config_snapshot.generation++;
+    config_loaded = true;
+}
+
+LLVConfig llv_config(void) {
+    if (!config_loaded) llv_config_reload();
+    return &config_snapshot;
+}
+
 #undef new_env_var
-#define new_env_var(name, env_name, type, default_value, process_fn) \
+#define new_env_var(field, name, env_name, type, default_value, process_fn) \
     type name(void) { \
-        bool defined = false; \
-        type previous = default_value; \
-        if (!defined) { \
-            defined = true; \
-            char *str = getenv(#env_name); \
-            if (str != NULL) previous = process_fn(str); \
-        } \
-        return previous; \
+        return llv_config()->field; \
     }
 
 #include "env_var.incl"
@@ -8,8 +8,35 @@
 
 #include "../include/helper.h"
 
+/*
+    A snapshot of every variable in env_var.incl.
+    It is read once (lazily) and only re-read on `llv_config_reload`,
+    so the printers can consult it as often as they like.
+*/
+typedef struct _llv_config_t *LLVConfig;
+
+#undef new_env_var
+#define new_env_var(field, name, env_name, type, default_value, process_fn) \
+    type field;
+
+struct _llv_config_t {
+#include "env_var.incl"
+    unsigned generation; // bumped on every reload
+};
+
+/*
+    Returns the current snapshot, loading it on first use.
+*/
+LLVConfig llv_config(void);
+
+/*
+    Re-reads all the environment variables into the snapshot.
+*/
+void llv_config_reload(void);
+
+// Getters that just read from the snapshot (for the non hot paths)
 #undef new_env_var
-#define new_env_var(name, env_name, type, default_value, process_fn) \
+#define new_env_var(field, name, env_name, type, default_value, process_fn) \
     type name(void);
 
 #include "env_var.incl"
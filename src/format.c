@@ -0,0 +1,174 @@
+#include "format.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// `%.5g`
+#define FLT_PRECISION (5)
+#define FLT_SCALE_MIN (10000)
+#define FLT_SCALE_MAX (100000)
+
+static const unsigned long long format_powers_of_10[] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+    100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL,
+    10000000000000ULL, 100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+    100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL,
+};
+
+// every power of 10 a double holds exactly
+static const double format_exact_powers_of_10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+#define MAX_EXACT_POWER_OF_10 (22)
+
+// two digits at a time halves the divisions
+static const char format_digit_pairs[] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+int format_count_digits(unsigned long long n) {
+#ifdef __GNUC__
+    // log10(n) is about log2(n) * 1233 / 4096, which is either right or one short
+    int digits = ((64 - __builtin_clzll(n | 1)) * 1233) >> 12;
+    return digits + (n >= format_powers_of_10[digits]) + (n == 0);
+#else
+    int digits = 1;
+    while (digits < 20 && n >= format_powers_of_10[digits]) digits++;
+    return digits;
+#endif
+}
+
+int format_uint(wchar_t *dest, unsigned long long n) {
+    int len = format_count_digits(n);
+    wchar_t *out = dest + len;
+    while (n >= 100) {
+        const char *pair = &format_digit_pairs[(n % 100) * 2];
+        n /= 100;
+        *--out = pair[1];
+        *--out = pair[0];
+    }
+    if (n >= 10) {
+        const char *pair = &format_digit_pairs[n * 2];
+        *--out = pair[1];
+        *--out = pair[0];
+    } else {
+        *--out = '0' + n;
+    }
+    return len;
+}
+
+int format_int(wchar_t *dest, long long n) {
+    if (n < 0) {
+        *dest = '-';
+        // negate as unsigned so LLONG_MIN doesn't overflow
+        return format_uint(dest + 1, -(unsigned long long)n) + 1;
+    }
+    return format_uint(dest, n);
+}
+
+static int format_flt_fallback(wchar_t *dest, double flt) {
+    return swprintf(dest, FORMAT_MAX_LEN, L"%.5g", flt);
+}
+
+// `flt` scaled so that an exponent of `exp10` puts it in [1e4, 1e5), only
+// ever a single (correctly rounded) operation since the powers are exact.
+static double format_scale(double flt, int exp10) {
+    int shift = FLT_PRECISION - 1 - exp10;
+    return shift >= 0 ? flt * format_exact_powers_of_10[shift]
+                      : flt / format_exact_powers_of_10[-shift];
+}
+
+int format_flt(wchar_t *dest, double flt) {
+    if (isnan(flt) || isinf(flt)) return format_flt_fallback(dest, flt);
+
+    wchar_t *out = dest;
+    double magnitude = fabs(flt);
+    if (signbit(flt)) *out++ = '-';
+    if (magnitude == 0) {
+        *out++ = '0';
+        return out - dest;
+    }
+
+    // the binary exponent gives us the decimal one or one short of it
+    int exp2;
+    frexp(magnitude, &exp2);
+    int exp10 = (int)floor((exp2 - 1) * 0.30102999566398120);
+    int shift = FLT_PRECISION - 1 - exp10;
+    if (shift - 1 < -MAX_EXACT_POWER_OF_10 || shift > MAX_EXACT_POWER_OF_10) {
+        return format_flt_fallback(dest, flt);
+    }
+
+    double scaled = format_scale(magnitude, exp10);
+    if (scaled >= FLT_SCALE_MAX) scaled = format_scale(magnitude, ++exp10);
+
+    // we are only ever off by a fraction of an ulp, so unless we are right
+    // on the halfway point rounding here matches rounding the exact value.
+    double whole = floor(scaled);
+    if (fabs(scaled - whole - 0.5) < 1e-6) return format_flt_fallback(dest, flt);
+    unsigned long long digits = (unsigned long long)whole + (scaled - whole > 0.5);
+    if (digits >= FLT_SCALE_MAX) {
+        digits /= 10;
+        exp10++;
+    }
+    if (digits < FLT_SCALE_MIN) return format_flt_fallback(dest, flt);
+
+    wchar_t sig[FLT_PRECISION];
+    format_uint(sig, digits);
+    int sig_len = FLT_PRECISION;
+    while (sig_len > 1 && sig[sig_len - 1] == '0') sig_len--;
+
+    if (exp10 < -4 || exp10 >= FLT_PRECISION) {
+        // d.dddde+XX
+        *out++ = sig[0];
+        if (sig_len > 1) {
+            *out++ = '.';
+            for (int i = 1; i < sig_len; i++) *out++ = sig[i];
+        }
+        *out++ = 'e';
+        *out++ = exp10 < 0 ? '-' : '+';
+        int abs_exp = exp10 < 0 ? -exp10 : exp10;
+        if (abs_exp < 10) *out++ = '0';
+        out += format_uint(out, abs_exp);
+    } else if (exp10 >= 0) {
+        // ddd.dd
+        for (int i = 0; i <= exp10; i++) *out++ = sig[i];
+        if (sig_len > exp10 + 1) {
+            *out++ = '.';
+            for (int i = exp10 + 1; i < sig_len; i++) *out++ = sig[i];
+        }
+    } else {
+        // 0.000ddddd
+        *out++ = '0';
+        *out++ = '.';
+        for (int i = exp10 + 1; i < 0; i++) *out++ = '0';
+        for (int i = 0; i < sig_len; i++) *out++ = sig[i];
+    }
+    return out - dest;
+}
+
+int format_ptr(wchar_t *dest, void *ptr) {
+#if defined(__GLIBC__) && defined(__GNUC__)
+    static const char hex_digits[] = "0123456789abcdef";
+    if (ptr == NULL) {
+        // glibc's spelling of a null `%p`
+        const wchar_t nil[] = L"(nil)";
+        for (int i = 0; i < 5; i++) dest[i] = nil[i];
+        return 5;
+    }
+
+    unsigned long long n = (uintptr_t)ptr;
+    int len = (64 - __builtin_clzll(n) + 3) / 4;
+    dest[0] = '0';
+    dest[1] = 'x';
+    for (int i = len + 1; i >= 2; i--, n >>= 4) dest[i] = hex_digits[n & 15];
+    return len + 2;
+#else
+    // everyone spells `%p` differently
+    return swprintf(dest, FORMAT_MAX_LEN, L"%p", ptr);
+#endif
+}
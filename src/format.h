@@ -0,0 +1,32 @@
+#ifndef LLV_FORMAT_H
+#define LLV_FORMAT_H
+
+#include <wchar.h>
+
+/*
+    Formatters for node text, they match `%llu`, `%lld`, `%.5g` and `%p`
+    character for character but skip swprintf's locale and wide stream
+    handling.  None of them write a '\0'.
+*/
+
+// enough room for anything below (`%.5g` tops out at 12, `%p` at 18)
+#define FORMAT_MAX_LEN (24)
+
+/*
+    How many decimal digits `n` has (0 has 1).
+*/
+int format_count_digits(unsigned long long n);
+
+int format_uint(wchar_t *dest, unsigned long long n);
+
+int format_int(wchar_t *dest, long long n);
+
+/*
+    Same as `%.5g`, values it can't round exactly (i.e. halfway cases or very
+    large/small exponents) fall back to swprintf.
+*/
+int format_flt(wchar_t *dest, double flt);
+
+int format_ptr(wchar_t *dest, void *ptr);
+
+#endif /* LLV_FORMAT_H */
@@ -0,0 +1,361 @@
+#include "frame.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdarg.h>
+
+#include "../include/llv.h"
+#include "../include/helper.h"
+#include "../include/types/sink.h"
+#include "env_var.h"
+
+#ifdef UNIX_COMPATIBILITY
+    #include <unistd.h>
+    #include <errno.h>
+    #include <sys/uio.h>
+#endif
+
+#define ESC "\x1b"
+// moving the cursor costs ~8 bytes so we'll happily rewrite that many
+// unchanged cells rather than break a run in two
+#define MIN_RUN_GAP (8)
+
+static struct _frame_t frame_buf;
+static Frame cur_frame = &frame_buf;
+// for encoding text written outside of a frame
+static struct _frame_t frame_scratch;
+static bool frame_active = false;
+
+// the terminal sink remembers what is on screen for incremental output
+static struct _frame_t terminal_prev;
+// what we actually send to the terminal in incremental mode
+static struct _frame_t diff_out;
+static bool prev_frame_valid = false;
+static terminalSize prev_frame_size;
+static unsigned prev_frame_generation;
+
+static void frame_reserve(Frame frame, size_t extra) {
+    if (frame->len + extra <= frame->capacity) return;
+    size_t new_capacity = frame->capacity == 0 ? 1024 : frame->capacity * 2;
+    while (new_capacity < frame->len + extra) new_capacity *= 2;
+    char *bytes = (char*)malloc_with_oom(new_capacity, "Frame");
+    if (frame->len > 0) memcpy(bytes, frame->bytes, frame->len);
+    free(frame->bytes);
+    frame->bytes = bytes;
+    frame->capacity = new_capacity;
+}
+
+static void frame_append(Frame frame, const char *bytes, size_t len) {
+    frame_reserve(frame, len);
+    memcpy(frame->bytes + frame->len, bytes, len);
+    frame->len += len;
+}
+
+static void frame_append_position(Frame frame, int row, int col) {
+    char buf[32];
+    int len = snprintf(buf, sizeof(buf), ESC "[%d;%dH", row + 1, col + 1);
+    frame_append(frame, buf, len);
+}
+
+// we always emit utf8 regardless of locale, which also saves us a trip
+// through wcrtomb for every single cell
+static size_t frame_encode_utf8(char *out, wchar_t c) {
+    unsigned long code = (unsigned long)c;
+    if (code < 0x80) {
+        out[0] = (char)code;
+        return 1;
+    } else if (code < 0x800) {
+        out[0] = (char)(0xC0 | (code >> 6));
+        out[1] = (char)(0x80 | (code & 0x3F));
+        return 2;
+    } else if (code < 0x10000) {
+        out[0] = (char)(0xE0 | (code >> 12));
+        out[1] = (char)(0x80 | ((code >> 6) & 0x3F));
+        out[2] = (char)(0x80 | (code & 0x3F));
+        return 3;
+    } else if (code < 0x110000) {
+        out[0] = (char)(0xF0 | (code >> 18));
+        out[1] = (char)(0x80 | ((code >> 12) & 0x3F));
+        out[2] = (char)(0x80 | ((code >> 6) & 0x3F));
+        out[3] = (char)(0x80 | (code & 0x3F));
+        return 4;
+    }
+    // not a valid codepoint so just mark it
+    out[0] = '?';
+    return 1;
+}
+
+static void frame_append_wide(Frame frame, const wchar_t *str, int len) {
+    frame_reserve(frame, (size_t)len * 4);
+    char *out = frame->bytes + frame->len;
+    for (int i = 0; i < len; i++) {
+        if ((unsigned long)str[i] < 0x80) {
+            *out++ = (char)str[i];
+        } else {
+            out += frame_encode_utf8(out, str[i]);
+        }
+    }
+    frame->len = out - frame->bytes;
+}
+
+/*
+    Hands `prefix` followed by `bytes` to the terminal in (ideally) a single
+    syscall, anything printed through stdio beforehand goes out first.
+*/
+static void frame_output(const char *prefix, size_t prefix_len,
+                         const char *bytes, size_t len) {
+    fflush(stdout);
+    #ifdef UNIX_COMPATIBILITY
+        struct iovec iov[2] = {
+            { .iov_base = (void*)prefix, .iov_len = prefix_len },
+            { .iov_base = (void*)bytes, .iov_len = len },
+        };
+        struct iovec *cur = prefix_len > 0 ? iov : iov + 1;
+        int count = prefix_len > 0 ? 2 : 1;
+        while (count > 0) {
+            ssize_t res = writev(STDOUT_FILENO, cur, count);
+            if (res < 0) {
+                if (errno == EINTR) continue;
+                return;
+            }
+            // partial write so skip what we've already sent
+            while (count > 0 && (size_t)res >= cur->iov_len) {
+                res -= cur->iov_len;
+                cur++;
+                count--;
+            }
+            if (count > 0) {
+                cur->iov_base = (char*)cur->iov_base + res;
+                cur->iov_len -= res;
+            }
+        }
+    #else
+        fwrite(prefix, 1, prefix_len, stdout);
+        fwrite(bytes, 1, len, stdout);
+        fflush(stdout);
+    #endif
+}
+
+static int frame_count_rows(const char *bytes, size_t len) {
+    int rows = 0;
+    for (size_t i = 0; i < len; i++) rows += bytes[i] == '\n';
+    return rows;
+}
+
+// how many bytes make up the (utf8) character at the start of str
+static int frame_char_len(const char *str, const char *end) {
+    int len = 1;
+    while (str + len < end && (str[len] & 0xC0) == 0x80) len++;
+    return len;
+}
+
+static void frame_diff_row(int row, const char *old, const char *old_end,
+                           const char *new, const char *new_end) {
+    if (old_end - old == new_end - new && memcmp(old, new, new_end - new) == 0) return;
+
+    int col = 0;
+    int run_col = 0;
+    int unchanged = 0;
+    const char *run_start = NULL;
+    const char *run_end = NULL;
+    while (new < new_end) {
+        int new_len = frame_char_len(new, new_end);
+        int old_len = old < old_end ? frame_char_len(old, old_end) : 0;
+        if (new_len != old_len || memcmp(new, old, new_len) != 0) {
+            if (run_start == NULL) {
+                run_start = new;
+                run_col = col;
+            }
+            run_end = new + new_len;
+            unchanged = 0;
+        } else if (run_start != NULL && ++unchanged > MIN_RUN_GAP) {
+            frame_append_position(&diff_out, row, run_col);
+            frame_append(&diff_out, run_start, run_end - run_start);
+            run_start = NULL;
+        }
+        new += new_len;
+        old += old_len;
+        col++;
+    }
+
+    if (run_start != NULL) {
+        frame_append_position(&diff_out, row, run_col);
+        frame_append(&diff_out, run_start, run_end - run_start);
+    }
+
+    // the old row was longer so wipe the rest of it
+    if (old < old_end) {
+        frame_append_position(&diff_out, row, col);
+        frame_append(&diff_out, ESC "[K", strlen(ESC "[K"));
+    }
+}
+
+static void terminal_emit_incremental(LLVConfig config, const char *bytes, size_t len) {
+    terminalSize size = get_terminal_size();
+    int rows = frame_count_rows(bytes, len);
+    diff_out.len = 0;
+
+    // we need a bit of room below the frame for prompts, if the frame
+    // doesn't fit the terminal will scroll and our positions are meaningless
+    bool fits = rows + 2 <= size.height;
+    bool redraw = !prev_frame_valid || !fits ||
+                  size.width != prev_frame_size.width ||
+                  size.height != prev_frame_size.height ||
+                  config->generation != prev_frame_generation;
+
+    if (redraw) {
+        frame_append(&diff_out, CLEAR_SCREEN, strlen(CLEAR_SCREEN));
+        frame_append(&diff_out, bytes, len);
+    } else {
+        const char *new = bytes;
+        const char *new_end = new + len;
+        const char *old = terminal_prev.bytes;
+        const char *old_end = old + terminal_prev.len;
+        for (int row = 0; new < new_end; row++) {
+            const char *new_eol = memchr(new, '\n', new_end - new);
+            if (new_eol == NULL) new_eol = new_end;
+            const char *old_eol = old < old_end ? memchr(old, '\n', old_end - old) : NULL;
+            if (old_eol == NULL) old_eol = old_end;
+
+            frame_diff_row(row, old, old_eol, new, new_eol);
+
+            new = new_eol < new_end ? new_eol + 1 : new_end;
+            old = old_eol < old_end ? old_eol + 1 : old_end;
+        }
+        // leave the cursor below the frame and clear anything left over
+        // from the previous frame (or from prompts) that was down there
+        frame_append_position(&diff_out, rows, 0);
+        frame_append(&diff_out, ESC "[J", strlen(ESC "[J"));
+    }
+
+    frame_output(NULL, 0, diff_out.bytes, diff_out.len);
+
+    terminal_prev.len = 0;
+    frame_append(&terminal_prev, bytes, len);
+    prev_frame_valid = fits;
+    prev_frame_size = size;
+    prev_frame_generation = config->generation;
+}
+
+static void terminal_write(LLVSink sink, const char *bytes, size_t len) {
+    fwrite(bytes, 1, len, stdout);
+}
+
+static void terminal_write_frame(LLVSink sink, const char *bytes, size_t len, bool clear) {
+    LLVConfig config = llv_config();
+    if (config->alternate_screen) enter_alternate_screen();
+    if (config->incremental_output) {
+        enable_escape_sequences();
+        terminal_emit_incremental(config, bytes, len);
+    } else {
+        if (clear) enable_escape_sequences();
+        frame_output(CLEAR_SCREEN, clear ? strlen(CLEAR_SCREEN) : 0, bytes, len);
+        prev_frame_valid = false;
+    }
+}
+
+static void terminal_flush(LLVSink sink) {
+    fflush(stdout);
+}
+
+static void terminal_close(LLVSink sink) {
+    fflush(stdout);
+}
+
+LLVSink llv_stdout_sink(void) {
+    static struct _llv_sink_t terminal = {
+        .write = terminal_write,
+        .write_frame = terminal_write_frame,
+        .flush = terminal_flush,
+        .close = terminal_close,
+        .ctx = NULL,
+    };
+    return &terminal;
+}
+
+void frame_begin(void) {
+    cur_frame->len = 0;
+    frame_active = true;
+}
+
+void frame_end(bool clear) {
+    if (!frame_active) return;
+    frame_active = false;
+
+    LLVSink sink = llv_sink();
+    sink->write_frame(sink, cur_frame->bytes, cur_frame->len, clear);
+}
+
+void frame_abort(void) {
+    if (!frame_active) return;
+    frame_active = false;
+
+    LLVSink sink = llv_sink();
+    sink->write(sink, cur_frame->bytes, cur_frame->len);
+    sink->flush(sink);
+    prev_frame_valid = false;
+}
+
+void frame_flush(void) {
+    LLVSink sink = llv_sink();
+    sink->flush(sink);
+}
+
+void frame_invalidate(void) {
+    prev_frame_valid = false;
+}
+
+// outside of a frame everything is written straight to the sink
+static Frame frame_target(void) {
+    if (frame_active) return cur_frame;
+    frame_scratch.len = 0;
+    return &frame_scratch;
+}
+
+static void frame_target_done(Frame frame) {
+    if (frame != &frame_scratch) return;
+    LLVSink sink = llv_sink();
+    sink->write(sink, frame_scratch.bytes, frame_scratch.len);
+}
+
+void frame_write(const char *bytes, size_t len) {
+    Frame frame = frame_target();
+    frame_append(frame, bytes, len);
+    frame_target_done(frame);
+}
+
+void frame_printf(const char *fmt, ...) {
+    Frame frame = frame_target();
+    va_list args;
+    va_start(args, fmt);
+    va_list copy;
+    va_copy(copy, args);
+    int len = vsnprintf(NULL, 0, fmt, copy);
+    va_end(copy);
+    if (len > 0) {
+        // +1 for the '\0' vsnprintf insists on writing
+        frame_reserve(frame, len + 1);
+        vsnprintf(frame->bytes + frame->len, len + 1, fmt, args);
+        frame->len += len;
+    }
+    va_end(args);
+    frame_target_done(frame);
+}
+
+void frame_write_wide(const wchar_t *str, int len) {
+    Frame frame = frame_target();
+    frame_append_wide(frame, str, len);
+    frame_target_done(frame);
+}
+
+void frame_repeat_wide(wchar_t c, int count) {
+    char encoded[4];
+    size_t len = frame_encode_utf8(encoded, c);
+    Frame frame = frame_target();
+    frame_reserve(frame, len * count);
+    for (int i = 0; i < count; i++) {
+        memcpy(frame->bytes + frame->len, encoded, len);
+        frame->len += len;
+    }
+    frame_target_done(frame);
+}
@@ -0,0 +1,60 @@
+#ifndef LLV_FRAME_H
+#define LLV_FRAME_H
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <wchar.h>
+
+/*
+    Everything printed during an update is collected into a frame and only
+    handed to the current sink (see types/sink.h) once the update is finished.
+    For the terminal this lets us compare it against the previous frame and
+    (with LLV_INCREMENTAL_OUTPUT) only redraw the cells that actually changed.
+    Frames are always utf8 encoded and are handed to the terminal with a
+    single write.
+
+    Outside of `frame_begin`/`frame_end` the frame_write* functions write
+    straight to the sink.
+*/
+typedef struct _frame_t *Frame;
+
+struct _frame_t {
+    char *bytes;        // the text of the frame, rows are '\n' terminated
+    size_t len;
+    size_t capacity;
+};
+
+/*
+    Start collecting output into a new frame.
+*/
+void frame_begin(void);
+
+/*
+    Send the frame to the sink, clearing the screen beforehand if `clear` is set.
+*/
+void frame_end(bool clear);
+
+/*
+    Write out whatever we have so far as is (used before exiting on errors).
+*/
+void frame_abort(void);
+
+/*
+    Flush the sink, call before waiting on the user.
+*/
+void frame_flush(void);
+
+/*
+    Forget the previous frame so the next one is drawn in full.
+*/
+void frame_invalidate(void);
+
+void frame_write(const char *bytes, size_t len);
+
+void frame_printf(const char *fmt, ...);
+
+void frame_write_wide(const wchar_t *str, int len);
+
+void frame_repeat_wide(wchar_t c, int count);
+
+#endif /* LLV_FRAME_H */
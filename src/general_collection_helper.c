@@ -5,55 +5,81 @@
 #include <wchar.h>
 
 #include "../include/helper.h"
-
-int log10_int(int num) {
-    int log = 0;
-    while (num >= 10) {
-        num /= 10;
-        log++;
-    }
-    return log;
-}
+#include "frame.h"
+#include "format.h"
 
 int sizeof_uint(unsigned long long int n) {
-    return (n == 0) ? 1 : log10_int(n) + 1;
+    return format_count_digits(n);
 }
 
 int sizeof_int(long long int n) {
     if (n < 0) {
-        return sizeof_uint(n * -1) + 1;
+        return format_count_digits(-(unsigned long long)n) + 1;
     } else {
-        return sizeof_uint(n);
+        return format_count_digits(n);
     }
 }
 
-int sizeof_flt(double flt) {
-    wchar_t buf[MAX_SIZE_FLT];
-    int res = swprintf(buf, MAX_SIZE_FLT, L"%.5g", flt);
-    if (res < 0) {
-        fprintf(stderr, "BUG IN FLT PRINTER\n");
-        abort();
-    }
-    return (int)res;
-}
+#define NODE_TEXT_SLOTS (512)
 
-int sizeof_data(Data data, TypeTag tag) {
-    int node_size = 0;
+typedef struct _node_text_t {
+    unsigned long long bits;
+    TypeTag tag;
+    int len; // 0 if the slot is unused, numbers are never empty
+    wchar_t text[FORMAT_MAX_LEN];
+} NodeText;
+
+// direct mapped so a collision just formats again
+static NodeText node_text_cache[NODE_TEXT_SLOTS];
+
+// finds (or formats) the text for a number, strings aren't cached since
+// their contents can change behind the same pointer
+static NodeText *node_text(Data data, TypeTag tag) {
+    unsigned long long bits = 0;
+    memcpy(&bits, &data, sizeof(data) < sizeof(bits) ? sizeof(data) : sizeof(bits));
+    unsigned long long hash = (bits ^ (unsigned long long)tag) * 0x9E3779B97F4A7C15ULL;
+    NodeText *slot = &node_text_cache[(hash >> 32) % NODE_TEXT_SLOTS];
+    if (slot->len != 0 && slot->bits == bits && slot->tag == tag) return slot;
+
+    int res = -1;
     switch (tag) {
         case FLOAT: {
-            node_size = sizeof_flt(data.flt_data);
-        } break;
-        case STRING: {
-            node_size = strlen(data.str_data);
+            res = format_flt(slot->text, data.flt_data);
         } break;
         case INTEGER: {
-            node_size = sizeof_int(data.int_data);
+            res = format_int(slot->text, data.int_data);
         } break;
         case ANY: {
-            node_size = sizeof_uint((size_t)data.any_data);
+            res = format_ptr(slot->text, data.any_data);
         } break;
+        case STRING: break;
     }
-    return node_size;
+    if (res <= 0) {
+        fprintf(stderr, "BUG IN NODE TEXT FORMATTER\n");
+        abort();
+    }
+    slot->bits = bits;
+    slot->tag = tag;
+    slot->len = res;
+    return slot;
+}
+
+int sizeof_data(Data data, TypeTag tag) {
+    if (tag == STRING) return strlen(data.str_data);
+    return node_text(data, tag)->len;
+}
+
+int write_data_text(wchar_t *dest, int max_len, Data data, TypeTag tag) {
+    int len;
+    if (tag == STRING) {
+        char *str = data.str_data;
+        for (len = 0; len < max_len && str[len] != '\0'; len++) dest[len] = str[len];
+    } else {
+        NodeText *text = node_text(data, tag);
+        len = text->len < max_len ? text->len : max_len;
+        memcpy(dest, text->text, sizeof(wchar_t) * len);
+    }
+    return len;
 }
 
 void write_str_center_incr(wchar_t **buf, int *offset, int len,
@@ -61,3 +87,11 @@ void write_str_center_incr(wchar_t **buf, int *offset, int len,
     write_str_center_of_buf(buf, *offset, len, str, str_len);
     *offset += str_len;
 }
+
+void exit_too_small_for_terminal(void) {
+    frame_printf("Error: No valid sizing constraint matches terminal size; i.e. "
+                 "increase your terminal size since on current size can't even "
+                 "fit the bare minimum\n");
+    frame_abort();
+    exit(1);
+}
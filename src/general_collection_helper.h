@@ -13,6 +13,23 @@ int sizeof_int(long long int n);
 void write_str_center_incr(wchar_t **buf, int *offset, int len,
                            wchar_t *str, int str_len);
 
+/*
+    How many characters `data` takes up when drawn (see write_data_text).
+*/
 int sizeof_data(Data data, TypeTag tag);
 
+/*
+    Writes at most `max_len` characters of the text for `data` to `dest`
+    (no '\0'), returning how many were written.  Numbers are formatted once and
+    cached by value so sizing then drawing a node (or redrawing it next frame)
+    doesn't format it again.
+*/
+int write_data_text(wchar_t *dest, int max_len, Data data, TypeTag tag);
+
+/*
+    Prints out an error (after whatever we have printed so far) and exits.
+    Used when not even the bare minimum of a collection fits on the terminal.
+*/
+void exit_too_small_for_terminal(void);
+
 #endif /* LLV_GENERAL_COLLECTION_HELPER */
@@ -0,0 +1,521 @@
+#include "../include/types/sink.h"
+
+#include <string.h>
+#include <stdint.h>
+
+#include "../include/helper.h"
+#include "bitmap_font.h"
+#include "env_var.h"
+
+/*
+    Each frame is rasterized with the bitmap font and the region that changed
+    since the previous frame is encoded as soon as it is written, all we keep
+    is the previous frame's cells.  A frame is held back until the next change
+    (so we know how long it stays up) and the gif is sized by the first frame,
+    growing it (by rewriting the header on close) if a later one is bigger.
+*/
+
+// how many pixels each pixel of the font becomes
+#define GIF_SCALE (2)
+#define GIF_CELL_WIDTH (FONT_CELL_WIDTH * GIF_SCALE)
+#define GIF_CELL_HEIGHT (FONT_CELL_HEIGHT * GIF_SCALE)
+// in 1/100ths of a second, used if LLV_SLEEP_TIME isn't set
+#define GIF_DEFAULT_DELAY (100)
+// the longest a frame can stay up, it is stored in 16 bits
+#define GIF_MAX_DELAY (65535)
+
+#define LZW_MAX_CODES (4096)
+#define LZW_MAX_CODE_SIZE (12)
+// colours 0/1 are all we use but gifs need at least 2 bits per pixel
+#define LZW_MIN_CODE_SIZE (2)
+#define LZW_CLEAR_CODE (1 << LZW_MIN_CODE_SIZE)
+#define LZW_EOI_CODE (LZW_CLEAR_CODE + 1)
+#define LZW_COLOURS (1 << LZW_MIN_CODE_SIZE)
+
+// same colours list2gif.sh used (RoyalBlue4 and WhiteSmoke)
+static const unsigned char gif_palette[LZW_COLOURS][3] = {
+    {0x27, 0x40, 0x8B},
+    {0xF5, 0xF5, 0xF5},
+    {0x00, 0x00, 0x00},
+    {0x00, 0x00, 0x00},
+};
+
+typedef struct _gif_bytes_t {
+    unsigned char *bytes;
+    size_t len;
+    size_t capacity;
+} *GifBytes;
+
+static void gif_reserve(GifBytes out, size_t extra) {
+    if (out->len + extra <= out->capacity) return;
+    size_t new_capacity = out->capacity == 0 ? 4096 : out->capacity * 2;
+    while (new_capacity < out->len + extra) new_capacity *= 2;
+    unsigned char *bytes = (unsigned char*)malloc_with_oom(new_capacity, "Gif Bytes");
+    if (out->len > 0) memcpy(bytes, out->bytes, out->len);
+    free(out->bytes);
+    out->bytes = bytes;
+    out->capacity = new_capacity;
+}
+
+static void gif_append(GifBytes out, const void *bytes, size_t len) {
+    gif_reserve(out, len);
+    memcpy(out->bytes + out->len, bytes, len);
+    out->len += len;
+}
+
+static void gif_append_byte(GifBytes out, unsigned char byte) {
+    gif_reserve(out, 1);
+    out->bytes[out->len++] = byte;
+}
+
+static void gif_append_u16(GifBytes out, int value) {
+    gif_append_byte(out, value & 0xFF);
+    gif_append_byte(out, (value >> 8) & 0xFF);
+}
+
+/* LZW */
+
+typedef struct _lzw_state_t {
+    GifBytes out;
+    // data is written in sub blocks of up to 255 bytes, this is where the
+    // length of the current one lives
+    size_t block_start;
+    uint32_t bits;
+    int bit_count;
+    int code_size;
+    int next_code;
+    // our alphabet is tiny so the dictionary is just a table of children
+    uint16_t children[LZW_MAX_CODES][LZW_COLOURS];
+} *LzwState;
+
+static void lzw_put_byte(LzwState lzw, unsigned char byte) {
+    if (lzw->out->len - lzw->block_start == 256) {
+        lzw->out->bytes[lzw->block_start] = 255;
+        lzw->block_start = lzw->out->len;
+        gif_append_byte(lzw->out, 0);
+    }
+    gif_append_byte(lzw->out, byte);
+}
+
+static void lzw_put_code(LzwState lzw, int code) {
+    lzw->bits |= (uint32_t)code << lzw->bit_count;
+    lzw->bit_count += lzw->code_size;
+    while (lzw->bit_count >= 8) {
+        lzw_put_byte(lzw, lzw->bits & 0xFF);
+        lzw->bits >>= 8;
+        lzw->bit_count -= 8;
+    }
+}
+
+static void lzw_reset(LzwState lzw) {
+    memset(lzw->children, 0, sizeof(lzw->children));
+    lzw->code_size = LZW_MIN_CODE_SIZE + 1;
+    lzw->next_code = LZW_EOI_CODE + 1;
+}
+
+// the decoder adds to its dictionary one code behind us,
+// this keeps our code size in step with it
+static void lzw_grow(LzwState lzw) {
+    if (lzw->next_code == (1 << lzw->code_size) && lzw->code_size < LZW_MAX_CODE_SIZE) {
+        lzw->code_size++;
+    }
+}
+
+static void lzw_encode(LzwState lzw, GifBytes out, const unsigned char *pixels, size_t count) {
+    lzw->out = out;
+    lzw->bits = 0;
+    lzw->bit_count = 0;
+    gif_append_byte(out, LZW_MIN_CODE_SIZE);
+    lzw->block_start = out->len;
+    gif_append_byte(out, 0);
+
+    lzw_reset(lzw);
+    lzw_put_code(lzw, LZW_CLEAR_CODE);
+
+    int prefix = pixels[0];
+    for (size_t i = 1; i < count; i++) {
+        int pixel = pixels[i];
+        int child = lzw->children[prefix][pixel];
+        if (child != 0) {
+            prefix = child;
+            continue;
+        }
+
+        lzw_put_code(lzw, prefix);
+        if (lzw->next_code < LZW_MAX_CODES) {
+            lzw->children[prefix][pixel] = lzw->next_code;
+            lzw_grow(lzw);
+            lzw->next_code++;
+        } else {
+            lzw_put_code(lzw, LZW_CLEAR_CODE);
+            lzw_reset(lzw);
+        }
+        prefix = pixel;
+    }
+    lzw_put_code(lzw, prefix);
+    if (lzw->next_code < LZW_MAX_CODES) lzw_grow(lzw);
+    lzw_put_code(lzw, LZW_EOI_CODE);
+    if (lzw->bit_count > 0) lzw_put_byte(lzw, lzw->bits & 0xFF);
+
+    // close off the last block and then the image data
+    lzw->out->bytes[lzw->block_start] = lzw->out->len - lzw->block_start - 1;
+    if (lzw->out->len - lzw->block_start > 1) gif_append_byte(out, 0);
+}
+
+/* Rasterizing */
+
+typedef struct _gif_screen_t {
+    int cols;
+    int rows;
+    wchar_t *cells;         // the text of the current frame
+    wchar_t *prev_cells;    // and the previous one
+} *GifScreen;
+
+// makes the screen at least `cols` x `rows` keeping the previous frame,
+// anything new is blank (which is what the gif shows there).
+static void gif_screen_grow(GifScreen screen, int cols, int rows) {
+    if (cols <= screen->cols && rows <= screen->rows) return;
+    if (cols < screen->cols) cols = screen->cols;
+    if (rows < screen->rows) rows = screen->rows;
+
+    size_t cell_count = (size_t)cols * rows;
+    wchar_t *prev = (wchar_t*)malloc_with_oom(sizeof(wchar_t) * cell_count, "Gif Cells");
+    wmemset(prev, L' ', cell_count);
+    for (int row = 0; row < screen->rows; row++) {
+        wmemcpy(prev + row * cols, screen->prev_cells + row * screen->cols, screen->cols);
+    }
+    free(screen->cells);
+    free(screen->prev_cells);
+    screen->cells = (wchar_t*)malloc_with_oom(sizeof(wchar_t) * cell_count, "Gif Cells");
+    screen->prev_cells = prev;
+    screen->cols = cols;
+    screen->rows = rows;
+}
+
+static int gif_decode_utf8(const unsigned char *str, const unsigned char *end, wchar_t *out) {
+    unsigned char c = str[0];
+    int len = c < 0x80 ? 1 : c < 0xE0 ? 2 : c < 0xF0 ? 3 : 4;
+    if (str + len > end) {
+        *out = L'?';
+        return 1;
+    }
+
+    if (len == 1) *out = c;
+    else if (len == 2) *out = ((c & 0x1F) << 6) | (str[1] & 0x3F);
+    else if (len == 3) *out = ((c & 0x0F) << 12) | ((str[1] & 0x3F) << 6) | (str[2] & 0x3F);
+    else *out = ((c & 0x07) << 18) | ((str[1] & 0x3F) << 12) |
+                ((str[2] & 0x3F) << 6) | (str[3] & 0x3F);
+    return len;
+}
+
+// measures the frame and lays it out onto `screen` (if given)
+static void gif_layout_frame(const unsigned char *text, size_t len, GifScreen screen,
+                             int *out_cols, int *out_rows) {
+    const unsigned char *end = text + len;
+    int row = 0, col = 0, cols = 0;
+    while (text < end) {
+        if (*text == '\n') {
+            if (col > cols) cols = col;
+            row++;
+            col = 0;
+            text++;
+            continue;
+        }
+
+        wchar_t c;
+        text += gif_decode_utf8(text, end, &c);
+        if (screen != NULL && row < screen->rows && col < screen->cols) {
+            screen->cells[row * screen->cols + col] = c;
+        }
+        col++;
+    }
+    if (col > cols) cols = col;
+    if (col > 0) row++;
+
+    if (out_cols != NULL) *out_cols = cols;
+    if (out_rows != NULL) *out_rows = row;
+}
+
+static void gif_rasterize(GifScreen screen, int x0, int y0, int x1, int y1,
+                          unsigned char *pixels) {
+    int width = (x1 - x0) * GIF_CELL_WIDTH;
+    unsigned char cell[FONT_CELL_HEIGHT][FONT_CELL_WIDTH];
+    for (int row = y0; row < y1; row++) {
+        for (int col = x0; col < x1; col++) {
+            bitmap_font_draw(screen->cells[row * screen->cols + col], cell);
+            unsigned char *origin = pixels + (row - y0) * GIF_CELL_HEIGHT * width +
+                                    (col - x0) * GIF_CELL_WIDTH;
+            for (int y = 0; y < GIF_CELL_HEIGHT; y++) {
+                unsigned char *line = origin + y * width;
+                for (int x = 0; x < GIF_CELL_WIDTH; x++) {
+                    line[x] = cell[y / GIF_SCALE][x / GIF_SCALE];
+                }
+            }
+        }
+    }
+}
+
+/* Writing */
+
+static void gif_write_header(GifBytes out, int width, int height) {
+    gif_append(out, "GIF89a", 6);
+    gif_append_u16(out, width);
+    gif_append_u16(out, height);
+    // global colour table of 2^(1 + 1) entries
+    gif_append_byte(out, 0x80 | (1 << 4) | (LZW_MIN_CODE_SIZE - 1));
+    gif_append_byte(out, 0);
+    gif_append_byte(out, 0);
+    gif_append(out, gif_palette, sizeof(gif_palette));
+
+    // loop forever
+    gif_append(out, "\x21\xFF\x0B" "NETSCAPE2.0" "\x03\x01\x00\x00\x00", 19);
+}
+
+static void gif_write_frame(GifBytes out, GifBytes image, int delay,
+                            int x, int y, int width, int height) {
+    // graphic control extension, the frame is left in place for the next one
+    gif_append(out, "\x21\xF9\x04", 3);
+    gif_append_byte(out, 1 << 2);
+    gif_append_u16(out, delay);
+    gif_append_byte(out, 0);
+    gif_append_byte(out, 0);
+
+    gif_append_byte(out, 0x2C);
+    gif_append_u16(out, x);
+    gif_append_u16(out, y);
+    gif_append_u16(out, width);
+    gif_append_u16(out, height);
+    gif_append_byte(out, 0);
+    gif_append(out, image->bytes, image->len);
+}
+
+/* Encoding */
+
+typedef struct _gif_sink_t {
+    FILE *file;
+    bool close_file;
+    bool finished;
+    int delay;
+    long header_at;         // where the header is in `file`, -1 if we can't go back to it
+    int header_cols;        // the size (in cells) the header gives
+    int header_rows;
+    struct _gif_screen_t screen;
+    unsigned char *pixels;
+    size_t pixels_capacity;
+    LzwState lzw;
+    struct _gif_bytes_t out;
+    // the last region that changed, written once we know how long it is up for
+    struct _gif_bytes_t pending;
+    int pending_x, pending_y, pending_width, pending_height;
+    int pending_delay;
+    bool have_pending;
+    struct _gif_sink_t *next;
+} *GifSink;
+
+// so gifs are still finished off even if the sink is never closed
+static GifSink open_gifs = NULL;
+
+static void gif_write_out(GifSink gif) {
+    fwrite(gif->out.bytes, 1, gif->out.len, gif->file);
+    gif->out.len = 0;
+}
+
+static void gif_write_pending(GifSink gif) {
+    if (!gif->have_pending) return;
+    gif_write_frame(&gif->out, &gif->pending, gif->pending_delay, gif->pending_x,
+                    gif->pending_y, gif->pending_width, gif->pending_height);
+    gif_write_out(gif);
+    // so a recording that is cut short still has everything up to here
+    fflush(gif->file);
+    gif->have_pending = false;
+}
+
+static void gif_set_pending(GifSink gif, int x, int y, int width, int height) {
+    gif->pending_x = x;
+    gif->pending_y = y;
+    gif->pending_width = width;
+    gif->pending_height = height;
+    gif->pending_delay = gif->delay;
+    gif->have_pending = true;
+    gif->pending.len = 0;
+}
+
+// nothing changed so the last frame stays up for longer, once that is more
+// than a frame can say a 1 pixel frame that changes nothing carries on for it.
+static void gif_hold(GifSink gif) {
+    if (gif->pending_delay <= GIF_MAX_DELAY - gif->delay) {
+        gif->pending_delay += gif->delay;
+        return;
+    }
+
+    gif_write_pending(gif);
+    unsigned char cell[FONT_CELL_HEIGHT][FONT_CELL_WIDTH];
+    bitmap_font_draw(gif->screen.prev_cells[0], cell);
+    gif_set_pending(gif, 0, 0, 1, 1);
+    lzw_encode(gif->lzw, &gif->pending, &cell[0][0], 1);
+}
+
+static void gif_add_frame(GifSink gif, const unsigned char *text, size_t len) {
+    GifScreen screen = &gif->screen;
+    int cols, rows;
+    gif_layout_frame(text, len, NULL, &cols, &rows);
+    bool first = gif->header_cols == 0;
+    // there is nothing to show until something is printed
+    if (first && (cols == 0 || rows == 0)) return;
+
+    gif_screen_grow(screen, cols, rows);
+    size_t cell_count = (size_t)screen->cols * screen->rows;
+    wmemset(screen->cells, L' ', cell_count);
+    gif_layout_frame(text, len, screen, NULL, NULL);
+
+    if (first) {
+        gif->header_at = ftell(gif->file);
+        gif->header_cols = screen->cols;
+        gif->header_rows = screen->rows;
+        gif_write_header(&gif->out, screen->cols * GIF_CELL_WIDTH, screen->rows * GIF_CELL_HEIGHT);
+        gif_write_out(gif);
+    }
+
+    // the region that changed (in cells), the first frame is drawn in full
+    int x0 = 0, y0 = 0, x1 = screen->cols, y1 = screen->rows;
+    if (!first) {
+        x0 = screen->cols, y0 = screen->rows, x1 = 0, y1 = 0;
+        for (int row = 0; row < screen->rows; row++) {
+            wchar_t *cur = screen->cells + row * screen->cols;
+            wchar_t *prev = screen->prev_cells + row * screen->cols;
+            if (wmemcmp(cur, prev, screen->cols) == 0) continue;
+            if (row < y0) y0 = row;
+            y1 = row + 1;
+            for (int col = 0; col < screen->cols; col++) {
+                if (cur[col] == prev[col]) continue;
+                if (col < x0) x0 = col;
+                if (col + 1 > x1) x1 = col + 1;
+            }
+        }
+    }
+
+    if (x0 >= x1 || y0 >= y1) {
+        gif_hold(gif);
+        return;
+    }
+
+    gif_write_pending(gif);
+    gif_set_pending(gif, x0 * GIF_CELL_WIDTH, y0 * GIF_CELL_HEIGHT,
+                    (x1 - x0) * GIF_CELL_WIDTH, (y1 - y0) * GIF_CELL_HEIGHT);
+
+    size_t pixel_count = (size_t)gif->pending_width * gif->pending_height;
+    if (pixel_count > gif->pixels_capacity) {
+        free(gif->pixels);
+        gif->pixels = (unsigned char*)malloc_with_oom(pixel_count, "Gif Pixels");
+        gif->pixels_capacity = pixel_count;
+    }
+    gif_rasterize(screen, x0, y0, x1, y1, gif->pixels);
+    lzw_encode(gif->lzw, &gif->pending, gif->pixels, pixel_count);
+
+    wchar_t *tmp = screen->prev_cells;
+    screen->prev_cells = screen->cells;
+    screen->cells = tmp;
+}
+
+static void gif_finish(GifSink gif) {
+    if (gif->finished) return;
+    gif->finished = true;
+
+    if (gif->header_cols > 0) {
+        gif_write_pending(gif);
+        gif_append_byte(&gif->out, 0x3B);
+        gif_write_out(gif);
+
+        // a later frame was bigger than the first so the header has to say so
+        GifScreen screen = &gif->screen;
+        if ((screen->cols > gif->header_cols || screen->rows > gif->header_rows) &&
+                gif->header_at >= 0 && fseek(gif->file, gif->header_at + 6, SEEK_SET) == 0) {
+            gif_append_u16(&gif->out, screen->cols * GIF_CELL_WIDTH);
+            gif_append_u16(&gif->out, screen->rows * GIF_CELL_HEIGHT);
+            gif_write_out(gif);
+            fseek(gif->file, 0, SEEK_END);
+        }
+    }
+
+    if (gif->close_file) fclose(gif->file);
+    else fflush(gif->file);
+}
+
+static void gif_finish_all(void) {
+    for (GifSink gif = open_gifs; gif != NULL; gif = gif->next) gif_finish(gif);
+}
+
+/* Sink */
+
+static void gif_sink_write(LLVSink sink, const char *bytes, size_t len) {
+    // prompts and the like aren't part of the picture
+}
+
+static void gif_sink_write_frame(LLVSink sink, const char *bytes, size_t len, bool clear) {
+    GifSink gif = (GifSink)sink->ctx;
+    if (gif->finished) return;
+    gif_add_frame(gif, (const unsigned char*)bytes, len);
+}
+
+static void gif_sink_flush(LLVSink sink) {
+    GifSink gif = (GifSink)sink->ctx;
+    if (!gif->finished) fflush(gif->file);
+}
+
+static void gif_sink_close(LLVSink sink) {
+    GifSink gif = (GifSink)sink->ctx;
+    gif_finish(gif);
+
+    GifSink *link = &open_gifs;
+    while (*link != gif) link = &(*link)->next;
+    *link = gif->next;
+    free(gif->out.bytes);
+    free(gif->pending.bytes);
+    free(gif->pixels);
+    free(gif->lzw);
+    free(gif->screen.cells);
+    free(gif->screen.prev_cells);
+    free(gif);
+    free(sink);
+}
+
+LLVSink llv_gif_sink(FILE *file, bool close_file) {
+    GifSink ctx = (GifSink)malloc_with_oom(sizeof(struct _gif_sink_t), "Gif Sink");
+    ctx->file = file;
+    ctx->close_file = close_file;
+    ctx->finished = false;
+    int sleep_time = llv_config()->sleep_time;
+    ctx->delay = sleep_time > 0 ? (sleep_time + 5) / 10 : GIF_DEFAULT_DELAY;
+    if (ctx->delay > GIF_MAX_DELAY) ctx->delay = GIF_MAX_DELAY;
+    ctx->header_at = -1;
+    ctx->header_cols = ctx->header_rows = 0;
+    ctx->screen = (struct _gif_screen_t){.cols = 0, .rows = 0, .cells = NULL, .prev_cells = NULL};
+    ctx->pixels = NULL;
+    ctx->pixels_capacity = 0;
+    ctx->lzw = (LzwState)malloc_with_oom(sizeof(struct _lzw_state_t), "Gif LZW");
+    ctx->out = (struct _gif_bytes_t){0};
+    ctx->pending = (struct _gif_bytes_t){0};
+    ctx->have_pending = false;
+
+    static bool registered = false;
+    if (!registered) {
+        registered = true;
+        atexit(gif_finish_all);
+    }
+    ctx->next = open_gifs;
+    open_gifs = ctx;
+
+    LLVSink sink = (LLVSink)malloc_with_oom(sizeof(struct _llv_sink_t), "Sink");
+    sink->ctx = ctx;
+    sink->write = gif_sink_write;
+    sink->write_frame = gif_sink_write_frame;
+    sink->flush = gif_sink_flush;
+    sink->close = gif_sink_close;
+    return sink;
+}
+
+LLVSink llv_open_gif_sink(const char *path) {
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) return NULL;
+    return llv_gif_sink(file, true);
+}
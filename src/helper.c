@@ -6,6 +6,7 @@
 #include <ctype.h>
 #include <locale.h>
 #include <stdarg.h>
+#include <signal.h>
 
 #ifdef WINDOWS_COMPATIBILITY
     #include <windows.h>
@@ -23,6 +24,7 @@
 #endif
 
 #include "env_var.h"
+#include "../include/llv.h"
 
 void write_str_center_of_buf(wchar_t **buf, int offset, int len,
                              wchar_t *str, int str_len) {
@@ -35,28 +37,101 @@ void write_str_to_buf(wchar_t **buf, int offset, int len, int index,
 }
 
 terminalSize get_terminal_size(void) {
-    int cols, rows;
+    int cols = 0, rows = 0;
+    // this effects debuggers/tests
+    LLVConfig config = llv_config();
+    if (config->testing_activated || llv_headless()) {
+        return (terminalSize){.width = config->default_term_width,
+                              .height = config->default_term_height};
+    }
+
     #ifdef WINDOWS_COMPATIBILITY
         CONSOLE_SCREEN_BUFFER_INFO csbi;
         GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &csbi);
         cols = csbi.srWindow.Right - csbi.srWindow.Left + 1;
         rows = csbi.srWindow.Bottom - csbi.srWindow.Top + 1;
     #else
-        struct winsize w;
+        struct winsize w = {0};
         ioctl(STDOUT_FILENO, TIOCGWINSZ, &w);
         cols = w.ws_col;
         rows = w.ws_row;
     #endif
 
-    // this effects debuggers/tests
-    if (cols == 0 || testing_activated()) {
-        cols = get_default_term_width();
-        rows = get_default_term_height();
+    if (cols == 0) {
+        cols = config->default_term_width;
+        rows = config->default_term_height;
     }
 
     return (terminalSize){.width = cols, .height = rows};
 }
 
+void enable_escape_sequences(void) {
+    #ifdef WINDOWS_COMPATIBILITY
+        #ifndef ENABLE_VIRTUAL_TERMINAL_PROCESSING
+            #define ENABLE_VIRTUAL_TERMINAL_PROCESSING 0x0004
+        #endif
+        static bool enabled = false;
+        if (enabled) return;
+        enabled = true;
+        HANDLE out = GetStdHandle(STD_OUTPUT_HANDLE);
+        DWORD mode = 0;
+        if (GetConsoleMode(out, &mode)) {
+            SetConsoleMode(out, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+        }
+    #endif
+}
+
+static volatile sig_atomic_t in_alternate_screen = false;
+
+// this has to be async signal safe, so no stdio
+static void write_alternate_screen_leave(void) {
+    #ifdef WINDOWS_COMPATIBILITY
+        fputs(ALTERNATE_SCREEN_LEAVE, stdout);
+        fflush(stdout);
+    #else
+        ssize_t res = write(STDOUT_FILENO, ALTERNATE_SCREEN_LEAVE, strlen(ALTERNATE_SCREEN_LEAVE));
+        (void)res;
+    #endif
+}
+
+static void leave_alternate_screen_on_signal(int sig) {
+    if (in_alternate_screen) {
+        in_alternate_screen = false;
+        write_alternate_screen_leave();
+    }
+    signal(sig, SIG_DFL);
+    raise(sig);
+}
+
+void enter_alternate_screen(void) {
+    static bool registered = false;
+    if (in_alternate_screen) return;
+
+    enable_escape_sequences();
+    if (!registered) {
+        registered = true;
+        atexit(leave_alternate_screen);
+        signal(SIGINT, leave_alternate_screen_on_signal);
+        signal(SIGTERM, leave_alternate_screen_on_signal);
+        #ifdef UNIX_COMPATIBILITY
+            signal(SIGHUP, leave_alternate_screen_on_signal);
+            signal(SIGQUIT, leave_alternate_screen_on_signal);
+        #endif
+    }
+
+    fputs(ALTERNATE_SCREEN_ENTER, stdout);
+    fflush(stdout);
+    in_alternate_screen = true;
+}
+
+void leave_alternate_screen(void) {
+    if (!in_alternate_screen) return;
+    in_alternate_screen = false;
+    // anything still buffered belongs on the alternate screen
+    fflush(stdout);
+    write_alternate_screen_leave();
+}
+
 void sleep_ms(int ms) {
     #ifdef WINDOWS_COMPATIBILITY
         Sleep(ms);
@@ -150,6 +225,10 @@ bool atob(char *str) {
     return false;
 }
 
+char *str_identity(char *str) {
+    return str;
+}
+
 void assert_msg(bool expr, char *fmt, ...) {
 #ifndef NDEBUG
     if (!expr) {
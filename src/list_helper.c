@@ -8,13 +8,125 @@
 
 #include "../include/helper.h"
 #include "general_collection_helper.h"
+#include "canvas.h"
+#include "frame.h"
 #include "env_var.h"
 
-#define PTR_SYMBOL select_char_unicode(L'⌃', L'^')
+void print_out_nodes(Collection list, LLVConfig config, LLVTheme theme, FakeNode begin, int count,
+                     wchar_t **buf, int *node_sizes, int *offset, wchar_t *after_node);
 
-void print_bounding_box(wchar_t **buf, int offset, int len, int width);
-void print_out_nodes(Collection list, FakeNode begin, FakeNode end, wchar_t **buf, int *node_sizes,
-                         int *offset, wchar_t *after_node, int starting_size);
+static int *layout_sizes = NULL;
+static int layout_capacity = 0;
+static FakeNode *layout_nodes = NULL;
+static int layout_nodes_capacity = 0;
+
+int list_max_visible(int width, int after_node_len) {
+    return width / (EXTRA_WIDTH + after_node_len) + 1;
+}
+
+int *list_layout_sizes(int n) {
+    if (n > layout_capacity) {
+        free(layout_sizes);
+        layout_capacity = n < 64 ? 64 : n;
+        layout_sizes = (int*)malloc_with_oom(sizeof(int) * layout_capacity, "Layout Sizes");
+    }
+    return layout_sizes;
+}
+
+FakeNode *list_layout_nodes(int n) {
+    if (n > layout_nodes_capacity) {
+        free(layout_nodes);
+        layout_nodes_capacity = n < 64 ? 64 : n;
+        layout_nodes = (FakeNode*)malloc_with_oom(sizeof(FakeNode) * layout_nodes_capacity,
+                                                  "Layout Nodes");
+    }
+    return layout_nodes;
+}
+
+// the width of everything around the nodes (the arrows between them aside)
+static int list_layout_overhead(bool hidden_before, bool hidden_after, int after_node_len,
+                                int start_len, int end_len, int ellipses_len) {
+    int overhead = start_len;
+    if (hidden_before) overhead += ellipses_len;
+    if (hidden_after) overhead += after_node_len + ellipses_len + NULL_NODE_LEN;
+    else overhead += end_len;
+    return overhead;
+}
+
+void list_layout_around(Collection list, FakeNode head, FakeNode focus,
+                        FakeNode (*prev)(void *ctx, FakeNode n), void *ctx, int width,
+                        wchar_t *after_node, wchar_t *start_of_list, wchar_t *end_of_list,
+                        wchar_t *ellipses, ListLayout layout) {
+    int after_node_len = wcslen(after_node);
+    int start_len = wcslen(start_of_list);
+    int end_len = wcslen(end_of_list);
+    int ellipses_len = wcslen(ellipses);
+
+    // the focus sits in the middle of `sizes` with the nodes before it to its left
+    int window = list_max_visible(width, after_node_len);
+    int *sizes = list_layout_sizes(2 * window + 1);
+    FakeNode first = focus;
+    FakeNode last = focus;
+    int before = 0;
+    int after = 0;
+
+    sizes[window] = list->get_sizeof(focus);
+    // the nodes and the arrows between them
+    int nodes_len = sizes[window];
+    if (nodes_len + list_layout_overhead(first != head, last->next != NULL, after_node_len,
+                                         start_len, end_len, ellipses_len) > width) {
+        exit_too_small_for_terminal();
+    }
+
+    // alternate sides so the focus stays in the middle, once a side is full
+    // the other can have the rest of the room.
+    bool grow_before = true;
+    bool grow_after = true;
+    while (grow_before || grow_after) {
+        if (grow_after) {
+            FakeNode next = last->next;
+            int size = next == NULL || after == window ? 0 : list->get_sizeof(next);
+            if (next == NULL || after == window ||
+                    nodes_len + size + after_node_len +
+                    list_layout_overhead(first != head, next->next != NULL, after_node_len,
+                                         start_len, end_len, ellipses_len) > width) {
+                grow_after = false;
+            } else {
+                sizes[window + ++after] = size;
+                nodes_len += size + after_node_len;
+                last = next;
+            }
+        }
+
+        if (grow_before) {
+            FakeNode node = before == window ? NULL : prev(ctx, first);
+            int size = node == NULL ? 0 : list->get_sizeof(node);
+            if (node == NULL ||
+                    nodes_len + size + after_node_len +
+                    list_layout_overhead(node != head, last->next != NULL, after_node_len,
+                                         start_len, end_len, ellipses_len) > width) {
+                grow_before = false;
+            } else {
+                sizes[window - ++before] = size;
+                nodes_len += size + after_node_len;
+                first = node;
+            }
+        }
+    }
+
+    layout->everything_fits = true;
+    layout->hidden_before = first != head;
+    layout->hidden_after = last->next != NULL;
+    layout->count = nodes_len + list_layout_overhead(layout->hidden_before, layout->hidden_after,
+                                                     after_node_len, start_len, end_len,
+                                                     ellipses_len);
+    layout->front_start = first;
+    layout->front_shown = before + 1 + after;
+    layout->front_sizes = sizes + window - before;
+    layout->back_shown = 0;
+    layout->back_sizes = NULL;
+    layout->back_start = NULL;
+}
 
 int list_sizeof(void *n) {
     FakeNode node = (FakeNode)n;
@@ -27,21 +139,22 @@ int list_sizeof(void *n) {
       to how to fit even more pointers by placing above/below as well this could show nicer pointers
       then having just below.
 */
-void print_ptr(wchar_t **buf, int len, int count, char *ptr_name, int ptr_len, int offset) {
+void print_ptr(wchar_t **buf, int len, int count, char *ptr_name, int ptr_len, int offset,
+               int ptr_height, LLVTheme theme) {
     // @REFACTORING
     // this is just a very early version
     // I'm going to update this once I figure out visual ptrs a bit more
     // a lot of this is hand waivey and magic variables
     int i = 0;
-    while (i < get_ptr_height() && buf[len + i][offset] == PTR_SYMBOL) i++;
+    while (i < ptr_height && buf[len + i][offset] == theme->ptr_symbol) i++;
 
-    if (i == get_ptr_height()) {
+    if (i == ptr_height) {
         // we can fit two if we are clever
         // we want to make sure though that we haven't done this before
         // and find a level that we can fit the second one on
         i = 0;
-        while (i < get_ptr_height() && buf[len + i][offset + count] != ' ') i++;
-        if (i == get_ptr_height()) {
+        while (i < ptr_height && buf[len + i][offset + count] != ' ') i++;
+        if (i == ptr_height) {
             // oh no, we can't print this out :(
             // @TODO: figure out if we want to try something else
             return;
@@ -54,133 +167,157 @@ void print_ptr(wchar_t **buf, int len, int count, char *ptr_name, int ptr_len, i
         // ` -> ` so we can fit it
         int max = ptr_len + 1 > 7 ? 7 : ptr_len + 1;
         for (int j = offset + 4; j < offset + max; j++) buf[i + len][j] = ptr_name[j - offset - 4];
-        buf[i + len][offset + 3] = PTR_SYMBOL;
+        buf[i + len][offset + 3] = theme->ptr_symbol;
     } else {
         int max = ptr_len + 1 > 5 ? 5 : ptr_len + 1;
         for (int j = offset + 1; j < offset + max; j++) buf[i + len][j] = ptr_name[j - offset - 1];
-        buf[i + len][offset] = PTR_SYMBOL;
+        buf[i + len][offset] = theme->ptr_symbol;
     }
 }
 
 void list_print_node(void *n, wchar_t **buf, int size, int len, int offset) {
+    list_draw_node(n, buf, size, len, offset, llv_config(), llv_theme());
+}
+
+void list_draw_node(void *n, wchar_t **buf, int size, int len, int offset,
+                    LLVConfig config, LLVTheme theme) {
     FakeNode node = (FakeNode)n;
-    print_bounding_box(buf, offset, len, size);
-    wchar_t *text_to_print;
-    switch (node->data_tag) {
-        case FLOAT: {
-            text_to_print = (wchar_t*)malloc_with_oom(sizeof(wchar_t) * (size - EXTRA_WIDTH / 2 + 1), "Text to print");
-            swprintf(text_to_print, size - EXTRA_WIDTH / 2 + 1, L"%.5g", node->data.flt_data);
-        } break;
-        case STRING: {
-            int len = strlen(node->data.str_data);
-            text_to_print = (wchar_t*)malloc_with_oom(len * sizeof(wchar_t), "Text to print");
-            for (int i = 0; i < len; i++) text_to_print[i] = node->data.str_data[i];
-        } break;
-        case INTEGER: {
-            // note: we are including the '\0' room just to make nothing weird happen
-            // with snprintf, but we will completely ignore it below in memcpy.
-            text_to_print = (wchar_t*)malloc_with_oom(sizeof(wchar_t) * (size - EXTRA_WIDTH / 2 + 1), "Text to print");
-            swprintf(text_to_print, size - EXTRA_WIDTH / 2, L"%lld", node->data.int_data);
-        } break;
-        case ANY: {
-            text_to_print = (wchar_t*)malloc_with_oom(sizeof(wchar_t) * (size - EXTRA_WIDTH / 2 + 1), "Text to print");
-            swprintf(text_to_print, size - EXTRA_WIDTH / 2, L"%p", node->data.any_data);
-        } break;
+    print_bounding_box(buf, offset, len, size, theme);
+    if (node->ptr != NULL) {
+        print_ptr(buf, len, size, node->ptr, strlen(node->ptr), offset,
+                  config->ptr_height, theme);
     }
-    if (node->ptr != NULL) print_ptr(buf, len, size, node->ptr, strlen(node->ptr), offset);
 
     // our sizes are always buffered by '4'
-    // a sprintf or similar is just going to give us nasty '\0'
-    memcpy(buf[len / 2] + EXTRA_WIDTH/2 + offset, text_to_print, sizeof(wchar_t) * (size - EXTRA_WIDTH));
-    free(text_to_print);
+    write_data_text(buf[len / 2] + EXTRA_WIDTH / 2 + offset, size - EXTRA_WIDTH,
+                    node->data, node->data_tag);
 }
 
-void print_bounding_box(wchar_t **buf, int offset, int len, int width) {
-    write_str_repeat_char_vert(buf, offset, BOX_VERT, len, 0);
-    write_str_repeat_char_vert(buf, offset, BOX_VERT, len, width - 1);
-    write_str_repeat_char(buf[0], offset + 1, BOX_HORIZONTAL, width - 2);
-    buf[0][offset] = BOX_TOP_LEFT;
-    buf[0][offset + width - 1] = BOX_TOP_RIGHT;
-    write_str_repeat_char(buf[len - 1], offset, BOX_HORIZONTAL, width);
-    buf[len - 1][offset] = BOX_BOTTOM_LEFT;
-    buf[len - 1][offset + width - 1] = BOX_BOTTOM_RIGHT;
+void print_bounding_box(wchar_t **buf, int offset, int len, int width, LLVTheme theme) {
+    write_str_repeat_char_vert(buf, offset, theme->box_vert, len, 0);
+    write_str_repeat_char_vert(buf, offset, theme->box_vert, len, width - 1);
+    write_str_repeat_char(buf[0], offset + 1, theme->box_horizontal, width - 2);
+    buf[0][offset] = theme->box_top_left;
+    buf[0][offset + width - 1] = theme->box_top_right;
+    write_str_repeat_char(buf[len - 1], offset, theme->box_horizontal, width);
+    buf[len - 1][offset] = theme->box_bottom_left;
+    buf[len - 1][offset + width - 1] = theme->box_bottom_right;
 }
 
-void print_out_nodes(Collection list, FakeNode begin, FakeNode end, wchar_t **buf, int *node_sizes,
-                         int *offset, wchar_t *after_node, int starting_size) {
-    int i = starting_size;
-    FakeNode n;
-    for (n = begin; n != end; n = n->next, i++) {
-        list_print_node(n, buf, node_sizes[i], get_print_height(), *offset);
+void print_out_nodes(Collection list, LLVConfig config, LLVTheme theme, FakeNode begin, int count,
+                     wchar_t **buf, int *node_sizes, int *offset, wchar_t *after_node) {
+    FakeNode n = begin;
+    for (int i = 0; i < count; i++, n = n->next) {
+        list_draw_node(n, buf, node_sizes[i], config->print_height, *offset, config, theme);
         *offset += node_sizes[i];
-        if (n->next != end) {
-            write_str_center_incr(buf, offset, get_print_height(), after_node, wcslen(after_node));
+        if (i + 1 < count) {
+            write_str_center_incr(buf, offset, config->print_height, after_node, wcslen(after_node));
         }
     }
 }
 
-void list_print_general(Collection list, int len, int count, FakeNode forwards,
-                FakeNode backwards, int stop, int *node_sizes, wchar_t *after_node,
-                wchar_t *start_of_list, wchar_t *end_of_list, wchar_t *ellipses, FakeNode head,
-                char *collection_name) {
+void list_print_general(Collection list, LLVConfig config, LLVTheme theme, ListLayout layout,
+                        wchar_t *after_node, wchar_t *start_of_list, wchar_t *end_of_list,
+                        wchar_t *ellipses, FakeNode head, char *collection_name) {
+    int count = layout->count;
     terminalSize size = get_terminal_size();
     assert_msg(size.width >= count, "list_helper:list_print_general, size.width (%d) must be >= count (%d)\n", size.width, count);
 
-    // now we have sizes we can allocate buffer and prepare to print list
-    // probably going to be a few characters bigger than we need but no harm no foul
-    wchar_t **buf = (wchar_t**)malloc_with_oom(sizeof(wchar_t*) * (get_print_height() + get_ptr_height()), "Buffer");
-    for (int i = 0; i < get_print_height() + get_ptr_height(); i++) {
-        buf[i] = (wchar_t*)malloc_with_oom((count + 1) * sizeof(wchar_t), "Buffer");
-        for (int j = 0; j < count; j++) buf[i][j] = ' ';
-        buf[i][count] = '\0';
-    }
+    // now we have sizes we can prepare the canvas and print list
+    Canvas canvas = canvas_shared();
+    wchar_t **buf = canvas_reset(canvas, count, config->print_height + config->ptr_height);
 
     int offset = 0;
-    FakeNode forward_stop = forwards;
-    // if everything in the list fits on page
-    bool everything_fits = forward_stop == NULL;
-
     if (head == NULL) {
-        write_str_center_incr(buf, &offset, get_print_height(), NULL_NODE, wcslen(NULL_NODE));
+        write_str_center_incr(buf, &offset, config->print_height, NULL_NODE, wcslen(NULL_NODE));
     } else {
-        write_str_center_incr(buf, &offset, get_print_height(), start_of_list, wcslen(start_of_list));
-        print_out_nodes(list, head, forward_stop, buf, node_sizes, &offset, after_node, 0);
-
-        if (!everything_fits) {
-            write_str_center_incr(buf, &offset, get_print_height(), after_node, wcslen(after_node));
-            write_str_center_incr(buf, &offset, get_print_height(), ellipses, wcslen(ellipses));
-            int backwards_start = len;
-            backwards = backwards->next;
-            for (FakeNode n = backwards; n != NULL; n = n->next) backwards_start--;
-            print_out_nodes(list, backwards, NULL, buf, node_sizes, &offset, after_node, backwards_start);
+        write_str_center_incr(buf, &offset, config->print_height, start_of_list, wcslen(start_of_list));
+        if (layout->hidden_before) {
+            write_str_center_incr(buf, &offset, config->print_height, ellipses, wcslen(ellipses));
         }
+        print_out_nodes(list, config, theme, layout->front_start, layout->front_shown, buf,
+                        layout->front_sizes, &offset, after_node);
 
-        // print end character
-        write_str_center_incr(buf, &offset, get_print_height(), end_of_list, wcslen(end_of_list));
-    }
+        if (!layout->everything_fits) {
+            write_str_center_incr(buf, &offset, config->print_height, after_node, wcslen(after_node));
+            write_str_center_incr(buf, &offset, config->print_height, ellipses, wcslen(ellipses));
+        } else if (layout->front_shown > 0 && layout->back_shown > 0) {
+            // the two halves meet up so they are joined like any other nodes
+            write_str_center_incr(buf, &offset, config->print_height, after_node, wcslen(after_node));
+        }
+        print_out_nodes(list, config, theme, layout->back_start, layout->back_shown, buf,
+                        layout->back_sizes, &offset, after_node);
 
-    printf("%s: %s\n", collection_name, list->name);
-    for (int i = 0; i < get_print_height(); i++) {
-        printf("%ls\n", buf[i]);
-        free(buf[i]);
-    }
-    for (int i = get_print_height(); i < get_ptr_height() + get_print_height(); i++) {
-        bool found_non_space = false;
-        for (int j = 0; j < count; j++) {
-            if (buf[i][j] != ' ') {
-                found_non_space = true;
-                break;
-            }
+        // print end character
+        if (layout->hidden_after) {
+            write_str_center_incr(buf, &offset, config->print_height, after_node, wcslen(after_node));
+            write_str_center_incr(buf, &offset, config->print_height, ellipses, wcslen(ellipses));
+            write_str_center_incr(buf, &offset, config->print_height, NULL_NODE, NULL_NODE_LEN);
+        } else {
+            write_str_center_incr(buf, &offset, config->print_height, end_of_list, wcslen(end_of_list));
         }
-        if (found_non_space) printf("%ls\n", buf[i]);
-        free(buf[i]);
     }
 
+    frame_printf("%s: %s\n", collection_name, list->name);
+    canvas_print(canvas, config->print_height, true);
+
     assert_msg(offset == count, "list_helper:list_print_general, "
                                 "we promised to print out %d characters and "
                                 "printed out just %d\n", count, offset);
-    printf("\n");
+    frame_write("\n", 1);
+}
+
+FakeNode list_merge_sort(FakeNode head, fn_data_compare cmp, FakeNode *tail,
+                         int passes_per_frame, fn_sort_pass on_pass, void *ctx) {
+    if (cmp == NULL) cmp = data_compare;
+    if (passes_per_frame < 1) passes_per_frame = 1;
+    *tail = NULL;
+    if (head == NULL) return NULL;
+
+    // each pass merges neighbouring runs of `width` nodes into runs of `2 * width`
+    for (int width = 1, pass = 1;; width *= 2, pass++) {
+        FakeNode left = head;
+        FakeNode sorted_tail = NULL;
+        int merges = 0;
+        head = NULL;
+
+        while (left != NULL) {
+            merges++;
+            FakeNode right = left;
+            int left_len = 0;
+            while (left_len < width && right != NULL) {
+                left_len++;
+                right = right->next;
+            }
+            int right_len = width;
+
+            while (left_len > 0 || (right_len > 0 && right != NULL)) {
+                FakeNode next;
+                // taking from the left on ties keeps it stable
+                if (left_len > 0 && (right_len == 0 || right == NULL ||
+                    cmp(left->data, left->data_tag, right->data, right->data_tag) <= 0)) {
+                    next = left;
+                    left = left->next;
+                    left_len--;
+                } else {
+                    next = right;
+                    right = right->next;
+                    right_len--;
+                }
 
-    free(buf);
-    free(node_sizes);
+                if (sorted_tail != NULL) sorted_tail->next = next;
+                else head = next;
+                sorted_tail = next;
+            }
+            left = right;
+        }
+        sorted_tail->next = NULL;
+        *tail = sorted_tail;
+
+        bool done = merges <= 1;
+        if (on_pass != NULL && (done || pass % passes_per_frame == 0)) {
+            on_pass(ctx, head, sorted_tail);
+        }
+        if (done) return head;
+    }
 }
@@ -5,20 +5,15 @@
 
 #include "../include/types/collection_skeleton.h"
 #include "../include/types/shared_types.h"
+#include "../include/types/theme.h"
 #include "../include/helper.h"
+#include "env_var.h"
 
 #define NULL_NODE L"X"
 #define NULL_NODE_LEN wcslen(NULL_NODE)
 #define SPACES_ON_SIDE (2)
 #define EXTRA_WIDTH (4)
 
-#define BOX_HORIZONTAL select_char_unicode(L'═', L'=')
-#define BOX_BOTTOM_RIGHT select_char_unicode(L'╝', L'=')
-#define BOX_BOTTOM_LEFT select_char_unicode(L'╚', L'=')
-#define BOX_VERT select_char_unicode(L'║', L'|')
-#define BOX_TOP_LEFT select_char_unicode(L'╔', L'=')
-#define BOX_TOP_RIGHT select_char_unicode(L'╗', L'=')
-
 // make sure your struct can downcast to this
 // don't malloc this!
 typedef struct _fake_node_t {
@@ -32,9 +27,82 @@ int list_sizeof(void *n);
 
 void list_print_node(void *n, wchar_t **buf, int size, int len, int offset);
 
-void list_print_general(Collection list, int len, int count, FakeNode forwards,
-                FakeNode backwards, int stop, int *node_sizes, wchar_t *after_node,
-                wchar_t *start_of_list, wchar_t *end_of_list, wchar_t *ellipses, FakeNode head,
-                char *collection_name);
+/*
+    Same as list_print_node but with the config/theme supplied by the caller
+    (so printers can look them up once per frame rather than per node).
+*/
+void list_draw_node(void *n, wchar_t **buf, int size, int len, int offset,
+                    LLVConfig config, LLVTheme theme);
+
+void print_bounding_box(wchar_t **buf, int offset, int len, int width, LLVTheme theme);
+
+/*
+    Which nodes a list printer decided to show, `front_shown` nodes from
+    `front_start` (usually the head) followed by `back_shown` nodes starting
+    at `back_start`.  If not everything fits the two are split by the ellipses.
+    `hidden_before`/`hidden_after` mean there are nodes off either end of what
+    we show (i.e. when centred on a focus).  We only keep sizes for the nodes
+    we show so this doesn't grow with the list.
+*/
+typedef struct _list_layout_t {
+    int count;              // how many characters wide the printed list is
+    bool everything_fits;
+    bool hidden_before;
+    bool hidden_after;
+    FakeNode front_start;
+    int front_shown;
+    int *front_sizes;
+    int back_shown;
+    int *back_sizes;
+    FakeNode back_start;
+} *ListLayout;
+
+/*
+    The most nodes we could ever show from one end of a list, every node is at
+    least EXTRA_WIDTH + after_node_len wide so a list any longer can't fit.
+*/
+int list_max_visible(int width, int after_node_len);
+
+/*
+    Scratch space for at least `n` node sizes, it is reused by the next layout.
+*/
+int *list_layout_sizes(int n);
+
+/*
+    Scratch space for at least `n` nodes, it is reused by the next layout.
+*/
+FakeNode *list_layout_nodes(int n);
+
+/*
+    Lays out as many nodes as fit around `focus`, growing to either side.
+    Nodes after are reached through `next` and nodes before through
+    `prev(ctx, node)`, it is called once per step walking backwards in order;
+    first with `focus` then with whatever it returned last (it returns NULL
+    when there are no more, after which it isn't called).  Only the nodes we
+    look at are measured so this costs the same however far into the list
+    `focus` is.
+*/
+void list_layout_around(Collection list, FakeNode head, FakeNode focus,
+                        FakeNode (*prev)(void *ctx, FakeNode n), void *ctx, int width,
+                        wchar_t *after_node, wchar_t *start_of_list, wchar_t *end_of_list,
+                        wchar_t *ellipses, ListLayout layout);
+
+/*
+    Called after a sorting pass with the list as it is so far.
+*/
+typedef void(*fn_sort_pass)(void *ctx, FakeNode head, FakeNode tail);
+
+/*
+    Stable bottom up merge sort of the nodes from `head` by `cmp` (NULL for
+    data_compare), it only relinks `next` and allocates nothing.
+    If given `on_pass` is called every `passes_per_frame` merge passes and
+    after the last one.  The new head is returned and `tail` set to the new tail.
+*/
+FakeNode list_merge_sort(FakeNode head, fn_data_compare cmp, FakeNode *tail,
+                         int passes_per_frame, fn_sort_pass on_pass, void *ctx);
+
+void list_print_general(Collection list, LLVConfig config, LLVTheme theme, ListLayout layout,
+                        wchar_t *after_node, wchar_t *start_of_list, wchar_t *end_of_list,
+                        wchar_t *ellipses, FakeNode head, char *collection_name);
 
 #endif /* LLV_COLLECTION_HELPER */
@@ -8,6 +8,8 @@
 #include <assert.h>
 
 #include "list_helper.h"
+#include "canvas.h"
+#include "frame.h"
 #include "env_var.h"
 
 typedef struct _ll_visual_t {
@@ -18,12 +20,17 @@ typedef struct _ll_visual_t {
 
 VisualNode visual_ptrs = NULL;
 
+// -1 means we haven't been told so we go by LLV_HEADLESS
+static int headless_override = -1;
+static FILE *input_source = NULL;
+static bool input_exhausted = false;
+
 void update_collection(Collection c);
 
 void print_border(void) {
     terminalSize size = get_terminal_size();
-    for (int i = 0; i < size.width; i++) printf("%lc", BOX_HORIZONTAL);
-    printf("\n");
+    frame_repeat_wide(llv_theme()->box_horizontal, size.width);
+    frame_write("\n", 1);
 }
 
 void attach_ptr(void *node, char *ptr) {
@@ -47,6 +54,32 @@ bool deattach_ptr(void *node, char *ptr) {
     return false;
 }
 
+void llv_set_headless(bool headless) {
+    headless_override = headless;
+}
+
+bool llv_headless(void) {
+    if (headless_override != -1) return headless_override;
+    return llv_config()->headless;
+}
+
+void llv_set_input(FILE *input) {
+    input_source = input;
+    input_exhausted = false;
+}
+
+bool llv_input_eof(void) {
+    return input_exhausted;
+}
+
+static FILE *get_input(void) {
+    return input_source != NULL ? input_source : stdin;
+}
+
+static void check_read(int res) {
+    if (res == EOF) input_exhausted = true;
+}
+
 void input_wait(char *fmt, va_list args) {
     // sleep time doesn't effect this
     for (char *a = fmt; *a != '\0'; a++) {
@@ -54,32 +87,37 @@ void input_wait(char *fmt, va_list args) {
             assert((*(++a) == 'i') && "%i must be the last of the fmt");
             switch (*(++a)) {
                 case 'i': {
-                    printf("Enter an integer: ");
+                    frame_printf("Enter an integer: ");
+                    frame_flush();
                     int *i = va_arg(args, int*);
-                    scanf("%d", i);
+                    check_read(fscanf(get_input(), "%d", i));
                 } break;
                 case 'l': {
-                    printf("Enter a long integer: ");
+                    frame_printf("Enter a long integer: ");
+                    frame_flush();
                     long *i = va_arg(args, long*);
-                    scanf("%ld", i);
+                    check_read(fscanf(get_input(), "%ld", i));
                 } break;
                 case 'c': {
-                    printf("Enter a character: ");
+                    frame_printf("Enter a character: ");
+                    frame_flush();
                     char *c = va_arg(args, char*);
-                    scanf("%c", c);
+                    check_read(fscanf(get_input(), "%c", c));
                 } break;
                 case 's': {
-                    printf("Enter a string: ");
+                    frame_printf("Enter a string: ");
+                    frame_flush();
                     char *str = va_arg(args, char*);
-                    scanf("%s", str);
+                    check_read(fscanf(get_input(), "%s", str));
                 } break;
                 case 'f': {
-                    printf("Enter a floating pointer number: ");
+                    frame_printf("Enter a floating pointer number: ");
+                    frame_flush();
                     double *flt = va_arg(args, double*);
-                    scanf("%lf", flt);
+                    check_read(fscanf(get_input(), "%lf", flt));
                 } break;
                 default: {
-                    printf("Unknown %c", *a);
+                    frame_printf("Unknown %c", *a);
                 }
             }
         }
@@ -88,11 +126,15 @@ void input_wait(char *fmt, va_list args) {
 
 void update_wait(void) {
     // wait either a set amount of time or till key press
-    if (get_sleep_time() > 0) sleep_ms(get_sleep_time());
+    LLVConfig config = llv_config();
+    if (llv_headless()) return;
+    if (config->sleep_time > 0) sleep_ms(config->sleep_time);
     else {
-        printf("\nType enter to continue...\n");
+        frame_printf("\nType enter to continue...\n");
+        frame_flush();
         int c;
-        while ((c = getchar()) != '\n' && c != EOF);
+        while ((c = getc(get_input())) != '\n' && c != EOF);
+        if (c == EOF) input_exhausted = true;
     }
 }
 
@@ -112,7 +154,8 @@ void update_ptrs(bool remove) {
 }
 
 void fmt_update(char *fmt, ...) {
-    if (clear_on_update()) clear_screen();
+    LLVConfig config = llv_config();
+    frame_begin();
     print_border();
     va_list list;
     va_start(list, fmt);
@@ -125,7 +168,7 @@ void fmt_update(char *fmt, ...) {
                     // single node
                     FakeNode n = va_arg(list, FakeNode);
                     print_out_single_box(n, list_print_node, list_sizeof,
-                                         get_print_height());
+                                         config->print_height);
                 } break;
                 case 'l': {
                     Collection c = va_arg(list, Collection);
@@ -133,12 +176,13 @@ void fmt_update(char *fmt, ...) {
                 } break;
                 case 's': {
                     char *str = va_arg(list, char *);
-                    printf("%s\n", str);
+                    frame_printf("%s\n", str);
                 } break;
                 case 'i': {
                     a--; // go back to `%`
                     update_ptrs(true);
                     print_border();
+                    frame_end(config->clear_on_update && !llv_headless());
                     input_wait(a, list);
                     va_end(list);
                 } return;
@@ -148,15 +192,19 @@ void fmt_update(char *fmt, ...) {
     update_ptrs(true);
     va_end(list);
     print_border();
+    frame_end(config->clear_on_update && !llv_headless());
     update_wait();
 }
 
 void clear_screen(void) {
-    system(CLEAR_SCREEN);
+    enable_escape_sequences();
+    frame_write(CLEAR_SCREEN, strlen(CLEAR_SCREEN));
+    frame_flush();
+    frame_invalidate();
 }
 
 void update(int number, ...) {
-    if (clear_on_update()) clear_screen();
+    frame_begin();
     print_border();
     va_list list;
     va_start(list, number);
@@ -168,41 +216,21 @@ void update(int number, ...) {
     va_end(list);
     update_ptrs(true);
     print_border();
+    frame_end(llv_config()->clear_on_update && !llv_headless());
     update_wait();
 }
 
 void print_out_single_box(void *node, fn_print_node printer, fn_sizeof_node sizeof_n, int height) {
-    wchar_t **buf = (wchar_t**)malloc_with_oom(sizeof(wchar_t *) * (height + get_ptr_height()), "Single");
+    LLVConfig config = llv_config();
+    Canvas canvas = canvas_shared();
     int count = sizeof_n(node);
-    for (int i = 0; i < height + get_ptr_height(); i++) {
-        buf[i] = (wchar_t*)malloc_with_oom(sizeof(wchar_t) * (count + 1), "Single");
-        for (int j = 0; j < count; j++) buf[i][j] = ' ';
-        buf[i][count] = '\0';
-    }
+    wchar_t **buf = canvas_reset(canvas, count, height + config->ptr_height);
     printer(node, buf, count, height, 0);
-
-    for (int i = 0; i < height; i++) {
-        printf("%ls\n", buf[i]);
-        free(buf[i]);
-    }
-    for (int i = height; i < get_ptr_height() + height; i++) {
-        if (include_ptrs_on_single()) {
-            bool found_non_space = false;
-            for (int j = 0; j < count; j++) {
-                if (buf[i][j] != ' ') {
-                    found_non_space = true;
-                    break;
-                }
-            }
-            if (found_non_space) printf("%ls\n", buf[i]);
-        }
-        free(buf[i]);
-    }
-    free(buf);
+    canvas_print(canvas, height, config->include_ptrs_on_single);
 }
 
 void print_out_single_box_using_defaults(void *node, Collection c) {
-    print_out_single_box(node, c->node_printer, c->get_sizeof, get_print_height());
+    print_out_single_box(node, c->node_printer, c->get_sizeof, llv_config()->print_height);
 }
 
 void update_collection(Collection c) {
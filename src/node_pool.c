@@ -0,0 +1,124 @@
+#include "node_pool.h"
+
+#include <stdlib.h>
+
+#define NODE_SLAB_MIN_LEN (32)
+#define NODE_SLAB_MAX_LEN (16384)
+
+// the header is padded out so the nodes after it are suitably aligned
+struct _node_slab_t {
+    union {
+        struct {
+            NodeSlab next;
+            size_t size;
+        } slab;
+        long double align_ld;
+        long long align_ll;
+        void *align_ptr;
+    } header;
+};
+
+static NodePool registered_pools = NULL;
+
+static char *node_pool_new_slab(NodePool pool, size_t len) {
+    if (pool->slabs == NULL) pool->allocator = llv_allocator();
+    if (!pool->registered) {
+        pool->next_pool = registered_pools;
+        registered_pools = pool;
+        pool->registered = true;
+    }
+
+    size_t size = sizeof(struct _node_slab_t) + len * pool->node_size;
+    NodeSlab slab = (NodeSlab)llv_alloc(pool->allocator, size, pool->name);
+    slab->header.slab.next = pool->slabs;
+    slab->header.slab.size = size;
+    pool->slabs = slab;
+    return (char*)(slab + 1);
+}
+
+static void node_pool_grow(NodePool pool) {
+    if (pool->next_slab_len < NODE_SLAB_MIN_LEN) pool->next_slab_len = NODE_SLAB_MIN_LEN;
+
+    size_t len = pool->next_slab_len;
+    pool->unused = node_pool_new_slab(pool, len);
+    pool->unused_end = pool->unused + len * pool->node_size;
+
+    // slabs double so a big list only costs a handful of mallocs
+    if (len < NODE_SLAB_MAX_LEN) pool->next_slab_len = len * 2;
+}
+
+// an empty pool follows the current allocator
+static void node_pool_rebind(NodePool pool) {
+    if (pool->live == 0 && pool->slabs != NULL && pool->allocator != llv_allocator()) {
+        node_pool_release(pool);
+    }
+}
+
+void *node_pool_alloc(NodePool pool) {
+    node_pool_rebind(pool);
+
+    void *node;
+    if (pool->free_nodes != NULL) {
+        node = pool->free_nodes;
+        pool->free_nodes = *(void**)node;
+    } else {
+        if (pool->unused == pool->unused_end) node_pool_grow(pool);
+        node = pool->unused;
+        pool->unused += pool->node_size;
+    }
+    pool->live++;
+    return node;
+}
+
+void *node_pool_alloc_n(NodePool pool, size_t n) {
+    if (n == 0) return NULL;
+    node_pool_rebind(pool);
+
+    char *nodes;
+    size_t size = n * pool->node_size;
+    if ((size_t)(pool->unused_end - pool->unused) >= size) {
+        nodes = pool->unused;
+        pool->unused += size;
+    } else if (n <= NODE_SLAB_MIN_LEN) {
+        // small enough that it isn't worth stranding the rest of the slab
+        node_pool_grow(pool);
+        nodes = pool->unused;
+        pool->unused += size;
+    } else {
+        // a slab of its own, what's left of the current one stays usable
+        nodes = node_pool_new_slab(pool, n);
+    }
+    pool->live += n;
+    return nodes;
+}
+
+void node_pool_free(NodePool pool, void *node) {
+    if (node == NULL) return;
+    *(void**)node = pool->free_nodes;
+    pool->free_nodes = node;
+    pool->live--;
+}
+
+static void node_pool_empty(NodePool pool) {
+    pool->slabs = NULL;
+    pool->allocator = NULL;
+    pool->free_nodes = NULL;
+    pool->unused = pool->unused_end = NULL;
+    pool->next_slab_len = 0;
+    pool->live = 0;
+}
+
+void node_pool_release(NodePool pool) {
+    for (NodeSlab slab = pool->slabs; slab != NULL;) {
+        NodeSlab next = slab->header.slab.next;
+        llv_free(pool->allocator, slab, slab->header.slab.size);
+        slab = next;
+    }
+    node_pool_empty(pool);
+}
+
+void node_pool_forget(LLVAllocator allocator) {
+    for (NodePool pool = registered_pools; pool != NULL; pool = pool->next_pool) {
+        if (pool->slabs != NULL && pool->allocator == allocator) node_pool_empty(pool);
+    }
+}
@@ -0,0 +1,64 @@
+#ifndef LLV_NODE_POOL_H
+#define LLV_NODE_POOL_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "../include/types/allocator.h"
+
+/*
+    Hands out fixed size nodes from slabs so allocating is usually just a
+    pointer bump and nodes allocated together sit together in memory.
+    Freed nodes are recycled through a free list and once no nodes are
+    left out the slabs can all be released in O(number of slabs).
+
+    Slabs come from the allocator that was current when the pool took its
+    first one, once every node has been given back it moves to whatever is
+    current then.
+*/
+
+typedef struct _node_slab_t *NodeSlab;
+
+typedef struct _node_pool_t {
+    size_t node_size;
+    size_t live;            // nodes handed out and not given back
+    size_t next_slab_len;   // how many nodes the next slab will hold
+    void *free_nodes;       // given back nodes, linked through their first word
+    char *unused;           // what is left of the newest slab
+    char *unused_end;
+    NodeSlab slabs;
+    char *name;             // for the OOM message
+    LLVAllocator allocator; // where the slabs came from, NULL if there are none
+    struct _node_pool_t *next_pool; // every pool that has had a slab (see node_pool_forget)
+    bool registered;
+} *NodePool;
+
+// for a static pool of `type`
+#define NODE_POOL_INIT(type, name) { \
+    sizeof(type) < sizeof(void*) ? sizeof(void*) : sizeof(type), 0, 0, NULL, NULL, NULL, NULL, name, \
+    NULL, NULL, false \
+}
+
+void *node_pool_alloc(NodePool pool);
+
+/*
+    `n` nodes next to each other in memory, i.e. a single slab
+    for a big enough `n`.  Each can be given back on its own.
+*/
+void *node_pool_alloc_n(NodePool pool, size_t n);
+
+void node_pool_free(NodePool pool, void *node);
+
+/*
+    Frees every slab, only call this once every node is dead
+    (i.e. pool->live == 0 or you are throwing away all that's left).
+*/
+void node_pool_release(NodePool pool);
+
+/*
+    Empties every pool whose slabs came from `allocator` without freeing
+    them, for when the allocator has already thrown its memory away.
+*/
+void node_pool_forget(LLVAllocator allocator);
+
+#endif /* LLV_NODE_POOL_H */
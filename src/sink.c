@@ -0,0 +1,231 @@
+#include "../include/types/sink.h"
+
+#include <string.h>
+
+#include "../include/helper.h"
+#include "env_var.h"
+
+static LLVSink current_sink = NULL;
+static LLVSink default_sink = NULL;
+
+static LLVSink sink_new(void *ctx) {
+    LLVSink sink = (LLVSink)malloc_with_oom(sizeof(struct _llv_sink_t), "Sink");
+    sink->ctx = ctx;
+    return sink;
+}
+
+/* File */
+
+typedef struct _file_sink_t {
+    FILE *file;
+    bool close_file;
+} *FileSink;
+
+static void file_sink_write(LLVSink sink, const char *bytes, size_t len) {
+    FileSink file = (FileSink)sink->ctx;
+    fwrite(bytes, 1, len, file->file);
+}
+
+static void file_sink_write_frame(LLVSink sink, const char *bytes, size_t len, bool clear) {
+    FileSink file = (FileSink)sink->ctx;
+    if (clear) fputs(CLEAR_SCREEN, file->file);
+    fwrite(bytes, 1, len, file->file);
+}
+
+static void file_sink_flush(LLVSink sink) {
+    fflush(((FileSink)sink->ctx)->file);
+}
+
+static void file_sink_close(LLVSink sink) {
+    FileSink file = (FileSink)sink->ctx;
+    if (file->close_file) fclose(file->file);
+    else fflush(file->file);
+    free(file);
+    free(sink);
+}
+
+LLVSink llv_file_sink(FILE *file, bool close_file) {
+    FileSink ctx = (FileSink)malloc_with_oom(sizeof(struct _file_sink_t), "File Sink");
+    ctx->file = file;
+    ctx->close_file = close_file;
+
+    LLVSink sink = sink_new(ctx);
+    sink->write = file_sink_write;
+    sink->write_frame = file_sink_write_frame;
+    sink->flush = file_sink_flush;
+    sink->close = file_sink_close;
+    return sink;
+}
+
+LLVSink llv_open_file_sink(const char *path) {
+    FILE *file = fopen(path, "w");
+    if (file == NULL) return NULL;
+    return llv_file_sink(file, true);
+}
+
+/* Memory */
+
+typedef struct _memory_sink_t {
+    char *buf;
+    size_t capacity;
+    size_t len;
+    size_t *out_len;
+} *MemorySink;
+
+static void memory_sink_write(LLVSink sink, const char *bytes, size_t len) {
+    MemorySink mem = (MemorySink)sink->ctx;
+    if (mem->capacity == 0) return;
+
+    // always leave room for the '\0'
+    size_t room = mem->capacity - 1 - mem->len;
+    if (len > room) len = room;
+    memcpy(mem->buf + mem->len, bytes, len);
+    mem->len += len;
+    mem->buf[mem->len] = '\0';
+    if (mem->out_len != NULL) *mem->out_len = mem->len;
+}
+
+static void memory_sink_write_frame(LLVSink sink, const char *bytes, size_t len, bool clear) {
+    if (clear) memory_sink_write(sink, CLEAR_SCREEN, strlen(CLEAR_SCREEN));
+    memory_sink_write(sink, bytes, len);
+}
+
+static void memory_sink_flush(LLVSink sink) {
+}
+
+static void memory_sink_close(LLVSink sink) {
+    free(sink->ctx);
+    free(sink);
+}
+
+LLVSink llv_memory_sink(char *buf, size_t capacity, size_t *len) {
+    MemorySink ctx = (MemorySink)malloc_with_oom(sizeof(struct _memory_sink_t), "Memory Sink");
+    ctx->buf = buf;
+    ctx->capacity = capacity;
+    ctx->len = 0;
+    ctx->out_len = len;
+    if (capacity > 0) buf[0] = '\0';
+    if (len != NULL) *len = 0;
+
+    LLVSink sink = sink_new(ctx);
+    sink->write = memory_sink_write;
+    sink->write_frame = memory_sink_write_frame;
+    sink->flush = memory_sink_flush;
+    sink->close = memory_sink_close;
+    return sink;
+}
+
+/* Tee */
+
+typedef struct _tee_sink_t {
+    LLVSink first;
+    LLVSink second;
+} *TeeSink;
+
+static void tee_sink_write(LLVSink sink, const char *bytes, size_t len) {
+    TeeSink tee = (TeeSink)sink->ctx;
+    tee->first->write(tee->first, bytes, len);
+    tee->second->write(tee->second, bytes, len);
+}
+
+static void tee_sink_write_frame(LLVSink sink, const char *bytes, size_t len, bool clear) {
+    TeeSink tee = (TeeSink)sink->ctx;
+    tee->first->write_frame(tee->first, bytes, len, clear);
+    tee->second->write_frame(tee->second, bytes, len, clear);
+}
+
+static void tee_sink_flush(LLVSink sink) {
+    TeeSink tee = (TeeSink)sink->ctx;
+    tee->first->flush(tee->first);
+    tee->second->flush(tee->second);
+}
+
+static void tee_sink_close(LLVSink sink) {
+    TeeSink tee = (TeeSink)sink->ctx;
+    tee->first->close(tee->first);
+    tee->second->close(tee->second);
+    free(tee);
+    free(sink);
+}
+
+LLVSink llv_tee_sink(LLVSink first, LLVSink second) {
+    TeeSink ctx = (TeeSink)malloc_with_oom(sizeof(struct _tee_sink_t), "Tee Sink");
+    ctx->first = first;
+    ctx->second = second;
+
+    LLVSink sink = sink_new(ctx);
+    sink->write = tee_sink_write;
+    sink->write_frame = tee_sink_write_frame;
+    sink->flush = tee_sink_flush;
+    sink->close = tee_sink_close;
+    return sink;
+}
+
+/* Selection */
+
+static void close_default_sink(void) {
+    if (default_sink != NULL) default_sink->close(default_sink);
+    if (current_sink == default_sink) current_sink = NULL;
+    default_sink = NULL;
+}
+
+static LLVSink tee_env_file(LLVSink sink, char *path, char *env_name,
+                            LLVSink (*open)(const char *path)) {
+    if (path == NULL || *path == '\0') return sink;
+
+    LLVSink file = open(path);
+    if (file == NULL) {
+        fprintf(stderr, "Warning: can't open %s '%s' for writing\n", env_name, path);
+        return sink;
+    }
+    return llv_tee_sink(sink, file);
+}
+
+static LLVSink get_default_sink(void) {
+    static bool registered = false;
+    if (default_sink != NULL) return default_sink;
+
+    default_sink = llv_stdout_sink();
+    LLVConfig config = llv_config();
+    default_sink = tee_env_file(default_sink, config->record_file,
+                                "LLV_RECORD_FILE", llv_open_file_sink);
+    default_sink = tee_env_file(default_sink, config->asciicast_file,
+                                "LLV_ASCIICAST_FILE", llv_open_asciicast_sink);
+    default_sink = tee_env_file(default_sink, config->gif_file,
+                                "LLV_GIF_FILE", llv_open_gif_sink);
+    // so recordings are complete even if we exit mid way
+    if (!registered) {
+        registered = true;
+        atexit(close_default_sink);
+    }
+    return default_sink;
+}
+
+LLVSink llv_sink(void) {
+    if (current_sink == NULL) current_sink = get_default_sink();
+    return current_sink;
+}
+
+LLVSink llv_set_sink(LLVSink sink) {
+    LLVSink old = llv_sink();
+    current_sink = sink;
+    return old;
+}
+
+// tees `recording` onto whatever we are currently using
+static bool record_into(LLVSink recording) {
+    if (recording == NULL) return false;
+
+    LLVSink sink = llv_tee_sink(llv_sink(), recording);
+    if (current_sink == default_sink) default_sink = sink;
+    current_sink = sink;
+    return true;
+}
+
+bool llv_record_asciicast(const char *path) {
+    return record_into(llv_open_asciicast_sink(path));
+}
+
+bool llv_record_gif(const char *path) {
+    return record_into(llv_open_gif_sink(path));
+}
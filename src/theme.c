@@ -0,0 +1,66 @@
+#include "../include/types/theme.h"
+
+#include <stdbool.h>
+#include <locale.h>
+
+#include "../include/helper.h"
+#include "list_helper.h"
+#include "env_var.h"
+
+struct _llv_theme_t llv_ascii_theme = {
+    .box_horizontal = L'=',
+    .box_vert = L'|',
+    .box_top_left = L'=',
+    .box_top_right = L'=',
+    .box_bottom_left = L'=',
+    .box_bottom_right = L'=',
+    .ptr_symbol = L'^',
+    .ll_after_node = L" -> ",
+    .ll_end_of_list = L" -> " NULL_NODE,
+    .ll_ellipses = L"... -> ",
+    .dll_after_node = L" <-> ",
+    .dll_start_of_list = NULL_NODE L" <-> ",
+    .dll_end_of_list = L" <-> " NULL_NODE,
+    .dll_ellipses = L"... <-> ",
+};
+
+struct _llv_theme_t llv_unicode_theme = {
+    .box_horizontal = L'═',
+    .box_vert = L'║',
+    .box_top_left = L'╔',
+    .box_top_right = L'╗',
+    .box_bottom_left = L'╚',
+    .box_bottom_right = L'╝',
+    .ptr_symbol = L'⌃',
+    .ll_after_node = L" ➢ ",
+    .ll_end_of_list = L" ➢ " NULL_NODE,
+    .ll_ellipses = L"... ➢ ",
+    .dll_after_node = L" ⟺   ",
+    .dll_start_of_list = NULL_NODE L" ⟺  ",
+    .dll_end_of_list = L" ⟺   " NULL_NODE,
+    .dll_ellipses = L"... ⟺   ",
+};
+
+static LLVTheme user_theme = NULL;
+static LLVTheme picked_theme = NULL;
+static unsigned picked_generation = 0;
+
+LLVTheme llv_theme(void) {
+    if (user_theme != NULL) return user_theme;
+
+    // only re-pick if the config has been reloaded since
+    LLVConfig config = llv_config();
+    if (picked_theme == NULL || picked_generation != config->generation) {
+        picked_theme = supports_unicode() ? &llv_unicode_theme : &llv_ascii_theme;
+        picked_generation = config->generation;
+    }
+    return picked_theme;
+}
+
+void llv_set_theme(LLVTheme theme) {
+    #ifdef UNIX_COMPATIBILITY
+    // same as `supports_unicode` custom themes may well include unicode
+    if (theme != NULL) setlocale(LC_ALL, "");
+    #endif
+    user_theme = theme;
+}
@@ -1,5 +1,7 @@
 #include "../../include/types/shared_types.h"
 
+#include <string.h>
+
 Data data_int(long long data) {
     return (Data){.int_data = data};
 }
@@ -15,3 +17,65 @@ Data data_str(char *data) {
 Data data_any(void *data) {
     return (Data){.any_data = data};
 }
+
+DataArray data_array(const Data *data, TypeTag tag) {
+    return (DataArray){.items = data, .kind = DATA_ARRAY_DATA, .tag = tag};
+}
+
+Data data_array_at(DataArray array, int index) {
+    switch (array.kind) {
+        case DATA_ARRAY_DATA: return ((const Data*)array.items)[index];
+        case DATA_ARRAY_CHAR: return data_int(((const char*)array.items)[index]);
+        case DATA_ARRAY_SIGNED_CHAR: return data_int(((const signed char*)array.items)[index]);
+        case DATA_ARRAY_SHORT: return data_int(((const short*)array.items)[index]);
+        case DATA_ARRAY_INT: return data_int(((const int*)array.items)[index]);
+        case DATA_ARRAY_LONG: return data_int(((const long*)array.items)[index]);
+        case DATA_ARRAY_LONG_LONG: return data_int(((const long long*)array.items)[index]);
+        case DATA_ARRAY_UNSIGNED_CHAR:
+            return data_int(((const unsigned char*)array.items)[index]);
+        case DATA_ARRAY_UNSIGNED_SHORT:
+            return data_int(((const unsigned short*)array.items)[index]);
+        case DATA_ARRAY_UNSIGNED_INT: return data_int(((const unsigned int*)array.items)[index]);
+        case DATA_ARRAY_UNSIGNED_LONG: return data_int(((const unsigned long*)array.items)[index]);
+        case DATA_ARRAY_UNSIGNED_LONG_LONG:
+            return data_int(((const unsigned long long*)array.items)[index]);
+        case DATA_ARRAY_FLOAT: return data_flt(((const float*)array.items)[index]);
+        case DATA_ARRAY_DOUBLE: return data_flt(((const double*)array.items)[index]);
+        case DATA_ARRAY_STR: return data_str(((char *const*)array.items)[index]);
+        case DATA_ARRAY_ANY: return data_any(((void *const*)array.items)[index]);
+    }
+    return data_any(NULL);
+}
+
+// numbers first, then strings, then everything else
+static int data_compare_rank(TypeTag tag) {
+    switch (tag) {
+        case INTEGER: case FLOAT: return 0;
+        case STRING: return 1;
+        default: return 2;
+    }
+}
+
+int data_compare(Data a, TypeTag a_tag, Data b, TypeTag b_tag) {
+    int a_rank = data_compare_rank(a_tag);
+    int b_rank = data_compare_rank(b_tag);
+    if (a_rank != b_rank) return a_rank - b_rank;
+
+    switch (a_rank) {
+        case 0: {
+            if (a_tag == INTEGER && b_tag == INTEGER) {
+                return (a.int_data > b.int_data) - (a.int_data < b.int_data);
+            }
+            double a_flt = a_tag == INTEGER ? (double)a.int_data : a.flt_data;
+            double b_flt = b_tag == INTEGER ? (double)b.int_data : b.flt_data;
+            return (a_flt > b_flt) - (a_flt < b_flt);
+        } break;
+        case 1: {
+            if (a.str_data == NULL || b.str_data == NULL) {
+                return (a.str_data != NULL) - (b.str_data != NULL);
+            }
+            return strcmp(a.str_data, b.str_data);
+        } break;
+    }
+    return (a.any_data > b.any_data) - (a.any_data < b.any_data);
+}